@@ -0,0 +1,948 @@
+#ifndef _GLIBCXX_ARROW_OPTIONAL_VARIANT
+#define _GLIBCXX_ARROW_OPTIONAL_VARIANT 1
+
+#if __cplusplus > 201703L
+
+#include <bit>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <span>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <bits/functexcept.h>
+#include <bits/stl_algobase.h>
+#include <bits/unique_ptr.h>
+#include "fixed_optional.h"
+#include "fixed_variant.h"
+
+// The Arrow C data interface, as specified by Apache Arrow. These
+// definitions are ABI-stable and may also come from arrow/c/abi.h, hence
+// the shared guard.
+#ifndef ARROW_C_DATA_INTERFACE
+#define ARROW_C_DATA_INTERFACE
+
+#define ARROW_FLAG_DICTIONARY_ORDERED 1
+#define ARROW_FLAG_NULLABLE 2
+#define ARROW_FLAG_MAP_KEYS_NULLABLE 4
+
+extern "C" {
+
+struct ArrowSchema {
+    const char* format;
+    const char* name;
+    const char* metadata;
+    int64_t flags;
+    int64_t n_children;
+    struct ArrowSchema** children;
+    struct ArrowSchema* dictionary;
+    void (*release)(struct ArrowSchema*);
+    void* private_data;
+};
+
+struct ArrowArray {
+    int64_t length;
+    int64_t null_count;
+    int64_t offset;
+    int64_t n_buffers;
+    int64_t n_children;
+    const void** buffers;
+    struct ArrowArray** children;
+    struct ArrowArray* dictionary;
+    void (*release)(struct ArrowArray*);
+    void* private_data;
+};
+
+} // extern "C"
+
+#endif // ARROW_C_DATA_INTERFACE
+
+namespace std _GLIBCXX_VISIBILITY(default)
+{
+_GLIBCXX_BEGIN_NAMESPACE_VERSION
+
+// Conversion between columns of optionals or variants and Arrow arrays.
+//
+// export_optional_array writes a span of optional<_Tp> as an array of _Tp
+// with a validity bitmap. export_variant_array writes a span of
+// variant<_Types...> as a dense or sparse union whose type ids are the
+// alternative indices and whose children hold the alternatives. Each walks
+// its input once. The exported ArrowArray and ArrowSchema own their
+// buffers and free them from their release callbacks, as the interface
+// requires, so they can be handed to any Arrow consumer.
+//
+// arrow_optional_array and arrow_union_array go the other way without
+// copying: they check an array against its schema and read the elements in
+// place, as a const _Tp& into the values buffer for arithmetic _Tp. They
+// do not take ownership; the array must stay alive and unreleased.
+//
+// _Tp and the alternatives may be arithmetic types other than bool
+// (formats c, C, s, S, i, I, l, L, f and g), string or string_view (utf8,
+// read back as string_view) and, as an alternative only, monostate (the
+// null type).
+
+enum class arrow_union_mode { dense, sparse };
+
+namespace __detail
+{
+namespace __arrow
+{
+template<typename _Tp>
+concept __utf8 = is_same_v<_Tp, string> || is_same_v<_Tp, string_view>;
+
+template<typename _Tp>
+concept __primitive = is_arithmetic_v<_Tp> && !is_same_v<_Tp, bool>
+    && (is_integral_v<_Tp> ? sizeof(_Tp) <= 8
+                           : sizeof(_Tp) == 4 || sizeof(_Tp) == 8);
+
+template<typename _Tp>
+concept __value = __primitive<_Tp> || __utf8<_Tp>;
+
+template<typename _Tp>
+concept __alternative = __value<_Tp> || is_same_v<_Tp, monostate>;
+
+template<typename _Tp>
+constexpr const char*
+__format() noexcept
+{
+    if constexpr (is_same_v<_Tp, monostate>) {
+        return "n";
+    } else if constexpr (__utf8<_Tp>) {
+        return "u";
+    } else if constexpr (is_floating_point_v<_Tp>) {
+        return sizeof(_Tp) == 4 ? "f" : "g";
+    } else {
+        constexpr const char* __f[] = { "C", "S", "I", "L", "c", "s", "i", "l" };
+        return __f[4 * is_signed_v<_Tp> + std::countr_zero(sizeof(_Tp))];
+    }
+}
+
+// Buffers are 64-byte aligned and padded, as Arrow recommends.
+inline void*
+__allocate(size_t __bytes, bool __zero)
+{
+    const size_t __n = ((__bytes + 63) & ~size_t(63)) + (__bytes == 0) * 64;
+    void* __p = std::aligned_alloc(64, __n);
+    if (!__p) {
+        __throw_bad_alloc();
+    }
+    if (__zero) {
+        __builtin_memset(__p, 0, __n);
+    }
+    return __p;
+}
+
+struct _Array_data {
+    void* _M_owned[3] = {};
+    const void* _M_buffers[3] = {};
+    unique_ptr<ArrowArray[]> _M_children;
+    unique_ptr<ArrowArray*[]> _M_child_ptrs;
+
+    ~_Array_data()
+    {
+        for (void* __p : _M_owned) {
+            std::free(__p);
+        }
+    }
+
+    void
+    _M_reserve_children(size_t __n)
+    {
+        _M_children.reset(new ArrowArray[__n]());
+        _M_child_ptrs.reset(new ArrowArray*[__n]);
+        for (size_t __i = 0; __i < __n; ++__i) {
+            _M_child_ptrs[__i] = &_M_children[__i];
+        }
+    }
+};
+
+// Releases the children still owned by __a, then __a itself.
+inline void
+__release_array(ArrowArray* __a)
+{
+    for (int64_t __i = 0; __i < __a->n_children; ++__i) {
+        ArrowArray* __c = __a->children[__i];
+        if (__c->release) {
+            __c->release(__c);
+        }
+    }
+    delete static_cast<_Array_data*>(__a->private_data);
+    __a->release = nullptr;
+}
+
+// Hands __d over to __a, with the first __n_buffers of its buffers.
+inline void
+__init_array(ArrowArray* __a, unique_ptr<_Array_data> __d, size_t __length,
+             size_t __nulls, int64_t __n_buffers,
+             int64_t __n_children = 0) noexcept
+{
+    for (int64_t __i = 0; __i < __n_buffers; ++__i) {
+        if (!__d->_M_buffers[__i]) {
+            __d->_M_buffers[__i] = __d->_M_owned[__i];
+        }
+    }
+    *__a = ArrowArray{ int64_t(__length), int64_t(__nulls), 0, __n_buffers,
+                       __n_children, __d->_M_buffers, __d->_M_child_ptrs.get(),
+                       nullptr, &__release_array, __d.get() };
+    __d.release();
+}
+
+struct _Schema_data {
+    string _M_format;
+    string _M_name;
+    unique_ptr<ArrowSchema[]> _M_children;
+    unique_ptr<ArrowSchema*[]> _M_child_ptrs;
+};
+
+inline void
+__release_schema(ArrowSchema* __s)
+{
+    for (int64_t __i = 0; __i < __s->n_children; ++__i) {
+        ArrowSchema* __c = __s->children[__i];
+        if (__c->release) {
+            __c->release(__c);
+        }
+    }
+    delete static_cast<_Schema_data*>(__s->private_data);
+    __s->release = nullptr;
+}
+
+inline void
+__init_schema(ArrowSchema* __s, string __format, string __name,
+              size_t __n_children = 0)
+{
+    auto __d = std::make_unique<_Schema_data>(std::move(__format),
+                                              std::move(__name));
+    if (__n_children) {
+        __d->_M_children.reset(new ArrowSchema[__n_children]());
+        __d->_M_child_ptrs.reset(new ArrowSchema*[__n_children]);
+        for (size_t __i = 0; __i < __n_children; ++__i) {
+            __d->_M_child_ptrs[__i] = &__d->_M_children[__i];
+        }
+    }
+    *__s = ArrowSchema{ __d->_M_format.c_str(), __d->_M_name.c_str(), nullptr,
+                        ARROW_FLAG_NULLABLE, int64_t(__n_children),
+                        __d->_M_child_ptrs.get(), nullptr, &__release_schema,
+                        __d.get() };
+    __d.release();
+}
+
+inline void
+__check_utf8_size(size_t __bytes)
+{
+    if (__bytes > size_t(INT32_MAX)) {
+        __throw_length_error("arrow: utf8 data exceeds 2 GiB");
+    }
+}
+
+// Writes one union child. __pos is the position in the child: the running
+// count of the alternative for a dense union, the row for a sparse one,
+// whose children are allocated zeroed so that other rows need no writes.
+template<typename _Tp>
+struct _Writer {
+    unique_ptr<_Array_data> _M_d = std::make_unique<_Array_data>();
+    _Tp* _M_values = nullptr;
+
+    void
+    _M_init(size_t __capacity, bool __sparse)
+    {
+        _M_d->_M_owned[1] = __allocate(__capacity * sizeof(_Tp), __sparse);
+        _M_values = static_cast<_Tp*>(_M_d->_M_owned[1]);
+    }
+
+    void
+    _M_put(size_t __pos, const _Tp& __t) noexcept
+    {
+        _M_values[__pos] = __t;
+    }
+
+    void
+    _M_finish(ArrowArray* __a, size_t __length, bool) noexcept
+    {
+        __init_array(__a, std::move(_M_d), __length, 0, 2);
+    }
+};
+
+template<>
+struct _Writer<monostate> {
+    void _M_init(size_t, bool) noexcept { }
+
+    void _M_put(size_t, monostate) noexcept { }
+
+    void
+    _M_finish(ArrowArray* __a, size_t __length, bool) noexcept
+    {
+        __init_array(__a, std::make_unique<_Array_data>(), __length, __length,
+                     0);
+    }
+};
+
+template<__utf8 _Tp>
+struct _Writer<_Tp> {
+    unique_ptr<_Array_data> _M_d = std::make_unique<_Array_data>();
+    int32_t* _M_offsets = nullptr;
+    size_t _M_size = 0;
+    size_t _M_capacity = 0;
+
+    void
+    _M_init(size_t __capacity, bool)
+    {
+        _M_d->_M_owned[1] = __allocate((__capacity + 1) * sizeof(int32_t),
+                                       true);
+        _M_offsets = static_cast<int32_t*>(_M_d->_M_owned[1]);
+    }
+
+    void
+    _M_put(size_t __pos, string_view __s)
+    {
+        // The capacity never exceeds the largest int32 offset, so every
+        // put that would pass it comes here and is checked.
+        if (_M_size + __s.size() > _M_capacity) {
+            __check_utf8_size(_M_size + __s.size());
+            _M_capacity = std::min(std::max(_M_size + __s.size(),
+                                            2 * _M_capacity),
+                                   size_t(INT32_MAX));
+            void* __p = __allocate(_M_capacity, false);
+            if (_M_size) {
+                __builtin_memcpy(__p, _M_d->_M_owned[2], _M_size);
+            }
+            std::free(std::__exchange(_M_d->_M_owned[2], __p));
+        }
+        if (!__s.empty()) {
+            __builtin_memcpy(static_cast<char*>(_M_d->_M_owned[2]) + _M_size,
+                             __s.data(), __s.size());
+        }
+        _M_size += __s.size();
+        _M_offsets[__pos + 1] = int32_t(_M_size);
+    }
+
+    void
+    _M_finish(ArrowArray* __a, size_t __length, bool __sparse) noexcept
+    {
+        // Rows of other alternatives are empty strings: carry the end of
+        // the previous string forward over their zeroed offsets.
+        if (__sparse) {
+            for (size_t __i = 1; __i <= __length; ++__i) {
+                _M_offsets[__i] = std::max(_M_offsets[__i],
+                                           _M_offsets[__i - 1]);
+            }
+        }
+        if (!_M_d->_M_owned[2]) {
+            _M_d->_M_buffers[2] = _M_offsets; // Any non-null pointer.
+        }
+        __init_array(__a, std::move(_M_d), __length, 0, 3);
+    }
+};
+
+// Reads the values of an imported array, past its offset.
+template<typename _Tp>
+struct _Reader {
+    using view_type = const _Tp&;
+    static constexpr int64_t _S_buffers = 2;
+
+    const _Tp* _M_values = nullptr;
+
+    void
+    _M_init(const ArrowArray& __a)
+    {
+        _M_values = static_cast<const _Tp*>(__a.buffers[1]);
+        if (!_M_values && __a.length) {
+            __throw_invalid_argument("arrow: missing values buffer");
+        }
+        _M_values += __a.offset;
+    }
+
+    view_type _M_get(size_t __i) const noexcept { return _M_values[__i]; }
+};
+
+template<>
+struct _Reader<monostate> {
+    using view_type = monostate;
+    static constexpr int64_t _S_buffers = 0;
+
+    void _M_init(const ArrowArray&) noexcept { }
+
+    view_type _M_get(size_t) const noexcept { return {}; }
+};
+
+template<__utf8 _Tp>
+struct _Reader<_Tp> {
+    using view_type = string_view;
+    static constexpr int64_t _S_buffers = 3;
+
+    const int32_t* _M_offsets = nullptr;
+    const char* _M_data = nullptr;
+
+    void
+    _M_init(const ArrowArray& __a)
+    {
+        _M_offsets = static_cast<const int32_t*>(__a.buffers[1]);
+        _M_data = static_cast<const char*>(__a.buffers[2]);
+        if (!_M_offsets || !_M_data) {
+            __throw_invalid_argument("arrow: missing utf8 buffers");
+        }
+        _M_offsets += __a.offset;
+    }
+
+    view_type
+    _M_get(size_t __i) const noexcept
+    {
+        return view_type(_M_data + _M_offsets[__i],
+                         _M_offsets[__i + 1] - _M_offsets[__i]);
+    }
+};
+
+// Checks that __a is a live array with the shape described by the
+// format __f.
+inline void
+__check_live(const ArrowArray& __a, const ArrowSchema& __s)
+{
+    if (!__a.release || !__s.release) {
+        __throw_invalid_argument("arrow: array or schema was released");
+    }
+}
+
+inline void
+__check_array(const ArrowArray& __a, const ArrowSchema& __s, const char* __f,
+              int64_t __n_buffers, int64_t __n_children)
+{
+    __check_live(__a, __s);
+    if (std::strcmp(__s.format, __f) != 0 || __s.dictionary || __a.dictionary) {
+        __throw_invalid_argument("arrow: format does not match type");
+    }
+    if (__a.n_buffers != __n_buffers || __a.n_children != __n_children
+        || __s.n_children != __n_children || __a.length < 0
+        || __a.offset < 0) {
+        __throw_invalid_argument("arrow: malformed array");
+    }
+}
+
+// Checks that no element of __a is null. A variant has no null state, so
+// a union child other than the null type must not have any.
+inline void
+__check_no_nulls(const ArrowArray& __a)
+{
+    const uint8_t* __bits = static_cast<const uint8_t*>(__a.buffers[0]);
+    if (__a.null_count == 0 || (__a.null_count == -1 && !__bits)) {
+        return;
+    }
+    if (__a.null_count == -1) {
+        // Not counted by the producer: look at the bitmap.
+        for (int64_t __i = __a.offset; __i < __a.offset + __a.length; ++__i) {
+            if (!((__bits[__i / 8] >> (__i % 8)) & 1)) {
+                __throw_invalid_argument("arrow: null in a union child");
+            }
+        }
+        return;
+    }
+    __throw_invalid_argument("arrow: null in a union child");
+}
+
+// Checks a union child that holds alternative _Tp.
+template<typename _Tp>
+void
+__check_child(const ArrowArray& __a, const ArrowSchema& __s)
+{
+    __check_array(__a, __s, __format<_Tp>(), _Reader<_Tp>::_S_buffers, 0);
+    if constexpr (!is_same_v<_Tp, monostate>) {
+        __check_no_nulls(__a);
+    }
+}
+
+// Dispatches a visitor on the index of an arrow_variant_view, like
+// visit for variant_view.
+template<typename _Res, typename _Visitor, typename _View, typename _Seq>
+struct __vtable;
+
+template<typename _Res, typename _Visitor, typename _View, size_t... _Ind>
+struct __vtable<_Res, _Visitor, _View, index_sequence<_Ind...>> {
+    template<size_t _Np>
+    static _Res
+    _S_invoke(_Visitor&& __vis, const _View& __v)
+    {
+        return std::__invoke(std::forward<_Visitor>(__vis),
+                             __v.template _M_get<_Np>());
+    }
+
+    static constexpr _Res (*_S_table[])(_Visitor&&, const _View&)
+        = { &_S_invoke<_Ind>... };
+};
+
+} // namespace __arrow
+} // namespace __detail
+
+/**
+  * @brief Exports __in to __array and __schema as an array of _Tp with a
+  * validity bitmap.
+  *
+  * The values of disengaged elements are zero, or empty strings.
+  */
+template<typename _Tp>
+void
+export_optional_array(span<const optional<_Tp>> __in, ArrowArray* __array,
+                      ArrowSchema* __schema)
+{
+    namespace __a = __detail::__arrow;
+    static_assert(__a::__value<_Tp>, "unsupported Arrow value type");
+
+    const size_t __n = __in.size();
+    auto __d = std::make_unique<__a::_Array_data>();
+    __d->_M_owned[0] = __a::__allocate((__n + 7) / 8, true);
+    uint8_t* const __bits = static_cast<uint8_t*>(__d->_M_owned[0]);
+    const optional<_Tp>* const __p = __in.data();
+    size_t __valid = 0;
+
+    if constexpr (__a::__utf8<_Tp>) {
+        size_t __bytes = 0;
+        for (const optional<_Tp>& __o : __in) {
+            __bytes += __o ? __o->size() : 0;
+        }
+        __a::__check_utf8_size(__bytes);
+        __d->_M_owned[1] = __a::__allocate((__n + 1) * sizeof(int32_t), false);
+        __d->_M_owned[2] = __a::__allocate(__bytes, false);
+        int32_t* const __offsets = static_cast<int32_t*>(__d->_M_owned[1]);
+        char* const __data = static_cast<char*>(__d->_M_owned[2]);
+        size_t __size = 0;
+        __offsets[0] = 0;
+        for (size_t __i = 0; __i < __n; ++__i) {
+            if (__p[__i]) {
+                if (!__p[__i]->empty()) {
+                    __builtin_memcpy(__data + __size, __p[__i]->data(),
+                                     __p[__i]->size());
+                }
+                __size += __p[__i]->size();
+                __bits[__i / 8] |= uint8_t(1) << (__i % 8);
+                ++__valid;
+            }
+            __offsets[__i + 1] = int32_t(__size);
+        }
+    } else {
+        // Eight rows per bitmap byte, without branches: disengaged rows
+        // take a zero value, which the compiler selects rather than jumps
+        // over.
+        __d->_M_owned[1] = __a::__allocate(__n * sizeof(_Tp), false);
+        _Tp* const __values = static_cast<_Tp*>(__d->_M_owned[1]);
+        for (size_t __i = 0; __i < __n; __i += 8) {
+            const size_t __m = std::min(__n - __i, size_t(8));
+            uint8_t __byte = 0;
+            for (size_t __j = 0; __j < __m; ++__j) {
+                const optional<_Tp>& __o = __p[__i + __j];
+                const bool __e = __o.has_value();
+                __values[__i + __j] = __e ? *__o : _Tp();
+                __byte |= uint8_t(__e) << __j;
+            }
+            __bits[__i / 8] = __byte;
+            __valid += std::popcount(__byte);
+        }
+    }
+
+    __a::__init_schema(__schema, __a::__format<_Tp>(), "");
+    __a::__init_array(__array, std::move(__d), __n, __n - __valid,
+                      __a::__utf8<_Tp> ? 3 : 2);
+}
+
+/**
+  * @brief Exports __in to __array and __schema as a union whose type ids
+  * are the alternative indices.
+  *
+  * A dense union allocates each child for the whole input, because the
+  * child lengths are only known at the end of the single pass; pages of
+  * the unused tail are never touched. A valueless variant throws
+  * bad_variant_access.
+  */
+template<typename... _Types>
+void
+export_variant_array(span<const variant<_Types...>> __in, ArrowArray* __array,
+                     ArrowSchema* __schema,
+                     arrow_union_mode __mode = arrow_union_mode::dense)
+{
+    namespace __a = __detail::__arrow;
+    static_assert((__a::__alternative<_Types> && ...),
+                  "unsupported Arrow alternative type");
+    static_assert(sizeof...(_Types) <= 128, "too many union members");
+    constexpr size_t _Nm = sizeof...(_Types);
+
+    const bool __sparse = __mode == arrow_union_mode::sparse;
+    const size_t __n = __in.size();
+    auto __d = std::make_unique<__a::_Array_data>();
+    __d->_M_owned[0] = __a::__allocate(__n, false);
+    int8_t* const __ids = static_cast<int8_t*>(__d->_M_owned[0]);
+    int32_t* __offsets = nullptr;
+    if (!__sparse) {
+        __d->_M_owned[1] = __a::__allocate(__n * sizeof(int32_t), false);
+        __offsets = static_cast<int32_t*>(__d->_M_owned[1]);
+    }
+    tuple<__a::_Writer<_Types>...> __w;
+    std::apply([__n, __sparse](auto&... __c) {
+        (__c._M_init(__n, __sparse), ...);
+    }, __w);
+
+    size_t __counts[_Nm] = {};
+    for (size_t __i = 0; __i < __n; ++__i) {
+        const variant<_Types...>& __v = __in[__i];
+        if (__v.valueless_by_exception()) {
+            __throw_bad_variant_access("export_variant_array: valueless");
+        }
+        const size_t __k = __v.index();
+        const size_t __pos = __sparse ? __i : __counts[__k]++;
+        __ids[__i] = int8_t(__k);
+        if (!__sparse) {
+            __offsets[__i] = int32_t(__pos);
+        }
+        __detail::__variant::__raw_idx_visit(
+        [&__w, __pos](const auto& __alt, auto __idx) {
+            if constexpr (__idx != variant_npos) {
+                std::get<__idx>(__w)._M_put(__pos, __alt);
+            }
+        }, __v);
+    }
+
+    string __format = __sparse ? "+us:" : "+ud:";
+    for (size_t __k = 0; __k < _Nm; ++__k) {
+        __format += (__k ? "," : "") + std::to_string(__k);
+    }
+    __a::__init_schema(__schema, std::move(__format), "", _Nm);
+    [&]<size_t... _Ind>(index_sequence<_Ind...>) {
+        (__a::__init_schema(__schema->children[_Ind],
+                            __a::__format<_Types>(), std::to_string(_Ind)),
+         ...);
+    }(index_sequence_for<_Types...>());
+    __d->_M_reserve_children(_Nm);
+
+    // Nothing below throws.
+    [&]<size_t... _Ind>(index_sequence<_Ind...>) {
+        (std::get<_Ind>(__w)._M_finish(&__d->_M_children[_Ind],
+                                       __sparse ? __n : __counts[_Ind],
+                                       __sparse),
+         ...);
+    }(index_sequence_for<_Types...>());
+    __a::__init_array(__array, std::move(__d), __n, 0, __sparse ? 1 : 2, _Nm);
+}
+
+/**
+  * @brief An element of an arrow_optional_array.
+  */
+template<typename _Tp>
+class arrow_optional_view
+{
+    using _Reader = __detail::__arrow::_Reader<_Tp>;
+
+    const _Reader* _M_r;
+    size_t _M_i;
+    bool _M_engaged;
+
+public:
+    using value_type = _Tp;
+    using view_type = typename _Reader::view_type;
+
+    arrow_optional_view(const _Reader& __r, size_t __i, bool __e) noexcept
+        : _M_r(std::__addressof(__r)), _M_i(__i), _M_engaged(__e)
+    { }
+
+    bool has_value() const noexcept { return _M_engaged; }
+
+    explicit operator bool() const noexcept { return _M_engaged; }
+
+    view_type
+    operator*() const noexcept
+    {
+        __glibcxx_assert(_M_engaged);
+        return _M_r->_M_get(_M_i);
+    }
+
+    const _Tp*
+    operator->() const noexcept
+    requires is_reference_v<view_type>
+    {
+        return std::__addressof(**this);
+    }
+
+    view_type
+    value() const
+    {
+        if (!_M_engaged) {
+            __throw_bad_optional_access();
+        }
+        return **this;
+    }
+
+    template<typename _Up>
+    remove_cvref_t<view_type>
+    value_or(_Up&& __u) const
+    {
+        if (_M_engaged) {
+            return **this;
+        }
+        return static_cast<remove_cvref_t<view_type>>(std::forward<_Up>(__u));
+    }
+};
+
+/**
+  * @brief An Arrow array of _Tp with nulls, read in place as optionals.
+  */
+template<typename _Tp>
+class arrow_optional_array
+{
+    using _Reader = __detail::__arrow::_Reader<_Tp>;
+
+    _Reader _M_values;
+    const uint8_t* _M_valid = nullptr;
+    size_t _M_offset;
+    size_t _M_length;
+
+public:
+    using value_type = _Tp;
+    using view_type = typename _Reader::view_type;
+    using size_type = size_t;
+
+    // Throws invalid_argument unless __a is a live array of _Tp as
+    // described by __s.
+    arrow_optional_array(const ArrowArray& __a, const ArrowSchema& __s)
+        : _M_offset(__a.offset), _M_length(__a.length)
+    {
+        static_assert(__detail::__arrow::__value<_Tp>,
+                      "unsupported Arrow value type");
+        __detail::__arrow::__check_array(__a, __s,
+                                         __detail::__arrow::__format<_Tp>(),
+                                         _Reader::_S_buffers, 0);
+        if (__a.null_count != 0) {
+            _M_valid = static_cast<const uint8_t*>(__a.buffers[0]);
+            if (!_M_valid) {
+                __throw_invalid_argument("arrow: missing validity bitmap");
+            }
+        }
+        _M_values._M_init(__a);
+    }
+
+    size_type size() const noexcept { return _M_length; }
+
+    bool empty() const noexcept { return _M_length == 0; }
+
+    bool
+    has_value(size_type __i) const noexcept
+    {
+        __glibcxx_assert(__i < _M_length);
+        if (!_M_valid) {
+            return true;
+        }
+        const size_t __b = _M_offset + __i;
+        return (_M_valid[__b / 8] >> (__b % 8)) & 1;
+    }
+
+    arrow_optional_view<_Tp>
+    operator[](size_type __i) const noexcept
+    {
+        return { _M_values, __i, has_value(__i) };
+    }
+};
+
+template<typename... _Types>
+class arrow_union_array;
+
+/**
+  * @brief An element of an arrow_union_array.
+  */
+template<typename... _Types>
+class arrow_variant_view
+{
+    const arrow_union_array<_Types...>* _M_a;
+    size_t _M_index;
+    size_t _M_pos;
+
+public:
+    template<size_t _Np>
+    using _Alt = typename __detail::__variant::_Nth_type<_Np, _Types...>::type;
+
+    arrow_variant_view(const arrow_union_array<_Types...>& __a, size_t __index,
+                       size_t __pos) noexcept
+        : _M_a(std::__addressof(__a)), _M_index(__index), _M_pos(__pos)
+    { }
+
+    size_t index() const noexcept { return _M_index; }
+
+    constexpr bool valueless_by_exception() const noexcept { return false; }
+
+    // Not part of the interface: the view of alternative _Np, which must be
+    // the one held.
+    template<size_t _Np>
+    typename __detail::__arrow::_Reader<_Alt<_Np>>::view_type
+    _M_get() const noexcept
+    {
+        return _M_a->template _M_child<_Np>()._M_get(_M_pos);
+    }
+};
+
+/**
+  * @brief A dense or sparse Arrow union, read in place as variants.
+  *
+  * The type ids must be the alternative indices, as written by
+  * export_variant_array, and the children must have the formats of the
+  * alternatives. Only the null type child may have nulls: a union whose
+  * other children have any is rejected, since a variant cannot hold one.
+  */
+template<typename... _Types>
+class arrow_union_array
+{
+    static constexpr size_t _Nm = sizeof...(_Types);
+
+    tuple<__detail::__arrow::_Reader<_Types>...> _M_children;
+    size_t _M_child_length[_Nm];
+    const int8_t* _M_ids;
+    const int32_t* _M_offsets = nullptr;
+    size_t _M_offset;
+    size_t _M_length;
+
+public:
+    using value_type = variant<_Types...>;
+    using size_type = size_t;
+
+    // Throws invalid_argument unless __a is a live union of _Types... as
+    // described by __s.
+    arrow_union_array(const ArrowArray& __a, const ArrowSchema& __s)
+        : _M_offset(__a.offset), _M_length(__a.length)
+    {
+        namespace __ar = __detail::__arrow;
+        static_assert((__ar::__alternative<_Types> && ...),
+                      "unsupported Arrow alternative type");
+        __ar::__check_live(__a, __s);
+        const bool __dense = std::strncmp(__s.format, "+ud:", 4) == 0;
+        string __format = __dense ? "+ud:" : "+us:";
+        for (size_t __k = 0; __k < _Nm; ++__k) {
+            __format += (__k ? "," : "") + std::to_string(__k);
+        }
+        __ar::__check_array(__a, __s, __format.c_str(), __dense ? 2 : 1, _Nm);
+        _M_ids = static_cast<const int8_t*>(__a.buffers[0]);
+        if (__dense) {
+            _M_offsets = static_cast<const int32_t*>(__a.buffers[1]);
+        }
+        if (__a.length && (!_M_ids || (__dense && !_M_offsets))) {
+            __throw_invalid_argument("arrow: missing union buffers");
+        }
+        [&]<size_t... _Ind>(index_sequence<_Ind...>) {
+            ((__ar::__check_child<_Types>(*__a.children[_Ind],
+                                          *__s.children[_Ind]),
+              std::get<_Ind>(_M_children)._M_init(*__a.children[_Ind]),
+              _M_child_length[_Ind] = __a.children[_Ind]->length), ...);
+        }(index_sequence_for<_Types...>());
+    }
+
+    size_type size() const noexcept { return _M_length; }
+
+    bool empty() const noexcept { return _M_length == 0; }
+
+    // Throws bad_variant_access for a type id that is not an alternative
+    // index.
+    size_t
+    index(size_type __i) const
+    {
+        __glibcxx_assert(__i < _M_length);
+        const int8_t __id = _M_ids[_M_offset + __i];
+        if (__id < 0 || size_t(__id) >= _Nm) {
+            __throw_bad_variant_access("arrow_union_array: invalid type id");
+        }
+        return size_t(__id);
+    }
+
+    // Throws out_of_range if the element lies outside its child.
+    arrow_variant_view<_Types...>
+    operator[](size_type __i) const
+    {
+        const size_t __k = index(__i);
+        const int64_t __pos = _M_offsets ? _M_offsets[_M_offset + __i]
+                                         : int64_t(_M_offset + __i);
+        if (__pos < 0 || size_t(__pos) >= _M_child_length[__k]) {
+            __throw_out_of_range("arrow_union_array: offset out of range");
+        }
+        return { *this, __k, size_t(__pos) };
+    }
+
+    // Not part of the interface.
+    template<size_t _Np>
+    const auto&
+    _M_child() const noexcept
+    {
+        return std::get<_Np>(_M_children);
+    }
+};
+
+template<typename _Tp, typename... _Types>
+bool
+holds_alternative(const arrow_variant_view<_Types...>& __v) noexcept
+{
+    static_assert((is_same_v<_Tp, _Types> + ...) == 1,
+                  "T must occur exactly once in alternatives");
+    return __v.index() == __detail::__variant::__index_of_v<_Tp, _Types...>;
+}
+
+template<size_t _Np, typename... _Types>
+typename __detail::__arrow::_Reader<
+    typename __detail::__variant::_Nth_type<_Np, _Types...>::type>::view_type
+get(const arrow_variant_view<_Types...>& __v)
+{
+    static_assert(_Np < sizeof...(_Types),
+                  "The index must be in [0, number of alternatives)");
+    if (__v.index() != _Np) {
+        __throw_bad_variant_access(false);
+    }
+    return __v.template _M_get<_Np>();
+}
+
+template<typename _Tp, typename... _Types>
+typename __detail::__arrow::_Reader<_Tp>::view_type
+get(const arrow_variant_view<_Types...>& __v)
+{
+    static_assert((is_same_v<_Tp, _Types> + ...) == 1,
+                  "T must occur exactly once in alternatives");
+    return std::get<__detail::__variant::__index_of_v<_Tp, _Types...>>(__v);
+}
+
+template<size_t _Np, typename... _Types>
+requires __detail::__arrow::__primitive<
+    typename __detail::__variant::_Nth_type<_Np, _Types...>::type>
+const typename __detail::__variant::_Nth_type<_Np, _Types...>::type*
+get_if(const arrow_variant_view<_Types...>* __ptr) noexcept
+{
+    if (__ptr && __ptr->index() == _Np) {
+        return std::__addressof(__ptr->template _M_get<_Np>());
+    }
+    return nullptr;
+}
+
+template<typename _Tp, typename... _Types>
+requires __detail::__arrow::__primitive<_Tp>
+const _Tp*
+get_if(const arrow_variant_view<_Types...>* __ptr) noexcept
+{
+    static_assert((is_same_v<_Tp, _Types> + ...) == 1,
+                  "T must occur exactly once in alternatives");
+    return std::get_if<__detail::__variant::__index_of_v<_Tp, _Types...>>(
+               __ptr);
+}
+
+// Invokes __vis with the held alternative: a const reference into the
+// child's values for arithmetic types, a string_view for strings and
+// monostate for the null type. Taken by value, like visit for
+// variant_view.
+template<typename _Visitor, typename... _Types>
+decltype(auto)
+visit(_Visitor&& __vis, arrow_variant_view<_Types...> __v)
+{
+    using _View = arrow_variant_view<_Types...>;
+    using _Res = invoke_result_t<_Visitor, typename __detail::__arrow::_Reader<
+        typename _View::template _Alt<0>>::view_type>;
+    using _Table = __detail::__arrow::__vtable<_Res, _Visitor, _View,
+                                               index_sequence_for<_Types...>>;
+    return _Table::_S_table[__v.index()](std::forward<_Visitor>(__vis), __v);
+}
+
+template<typename... _Types>
+struct variant_size<arrow_variant_view<_Types...>>
+    : std::integral_constant<size_t, sizeof...(_Types)> {};
+
+_GLIBCXX_END_NAMESPACE_VERSION
+} // namespace std
+
+#endif // C++20
+
+#endif // _GLIBCXX_ARROW_OPTIONAL_VARIANT
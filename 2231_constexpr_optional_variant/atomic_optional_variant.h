@@ -0,0 +1,462 @@
+#ifndef _GLIBCXX_ATOMIC_OPTIONAL_VARIANT
+#define _GLIBCXX_ATOMIC_OPTIONAL_VARIANT 1
+
+#if __cplusplus > 201703L
+
+#include <atomic>
+#include <bit>
+#include <cstdint>
+#include "fixed_optional.h"
+#include "fixed_variant.h"
+
+namespace std _GLIBCXX_VISIBILITY(default)
+{
+_GLIBCXX_BEGIN_NAMESPACE_VERSION
+
+namespace __detail
+{
+namespace __atomic_value
+{
+// Small trivially copyable optionals and variants are packed into a single
+// integer word: the payload bytes (with padding cleared) at offset 0 and the
+// engaged flag or alternative index in the byte after the largest payload.
+// The disengaged optional packs to the all-zero word. Two values pack to the
+// same word exactly when their object representations are equal, which is
+// what compare_exchange compares.
+
+template<size_t _Size>
+struct __word_for;
+
+template<> struct __word_for<1> { using type = uint8_t; };
+template<> struct __word_for<2> { using type = uint16_t; };
+template<> struct __word_for<4> { using type = uint32_t; };
+template<> struct __word_for<8> { using type = uint64_t; };
+template<> struct __word_for<16> {
+    __extension__ typedef unsigned __int128 type;
+};
+
+template<size_t _Size>
+using __word_t = typename __word_for<std::bit_ceil(_Size)>::type;
+
+template<typename _Tp>
+inline void
+__clear_padding(_Tp& __t) noexcept
+{
+#if __has_builtin(__builtin_clear_padding)
+    __builtin_clear_padding(std::__addressof(__t));
+#endif
+}
+
+template<typename _Tp>
+struct _Bytes {
+    unsigned char _M_b[sizeof(_Tp)];
+};
+
+// Lock-free operations on a 1, 2, 4, 8 or 16 byte word.
+//
+// 16 byte words use cmpxchg16b directly on x86-64, so they do not depend on
+// libatomic or -mcx16. cmpxchg16b is a full barrier, so the memory order
+// arguments only matter for the narrower words.
+//
+// A 16 byte load is an aligned vmovdqa when compiling for AVX, which Intel
+// and AMD both guarantee to be atomic on processors that support AVX.
+// Otherwise it is a cmpxchg16b that compares with zero and stores back what
+// it read: it takes the cache line exclusive like a store, so concurrent
+// readers of one object contend with each other.
+template<typename _Word>
+struct _Word_ops {
+    static constexpr bool _S_lock_free = __atomic_always_lock_free(
+        sizeof(_Word), 0);
+
+    static _Word
+    _S_load(_Word* __p, memory_order __m) noexcept
+    {
+        return __atomic_load_n(__p, int(__m));
+    }
+
+    static void
+    _S_store(_Word* __p, _Word __w, memory_order __m) noexcept
+    {
+        __atomic_store_n(__p, __w, int(__m));
+    }
+
+    static _Word
+    _S_exchange(_Word* __p, _Word __w, memory_order __m) noexcept
+    {
+        return __atomic_exchange_n(__p, __w, int(__m));
+    }
+
+    static bool
+    _S_compare_exchange(_Word* __p, _Word& __e, _Word __w, bool __weak,
+                        memory_order __s, memory_order __f) noexcept
+    {
+        return __atomic_compare_exchange_n(__p, &__e, __w, __weak,
+                                           int(__s), int(__f));
+    }
+};
+
+#if defined(__x86_64__)
+template<>
+struct _Word_ops<__word_for<16>::type> {
+    using _Word = __word_for<16>::type;
+
+    static constexpr bool _S_lock_free = true;
+
+    static bool
+    _S_cas(_Word* __p, _Word& __e, _Word __w) noexcept
+    {
+        bool __r;
+        uint64_t __lo = uint64_t(__e);
+        uint64_t __hi = uint64_t(__e >> 64);
+        __asm__ __volatile__("lock cmpxchg16b %1"
+                             : "=@ccz"(__r), "+m"(*__p),
+                               "+a"(__lo), "+d"(__hi)
+                             : "b"(uint64_t(__w)), "c"(uint64_t(__w >> 64))
+                             : "memory");
+        __e = (_Word(__hi) << 64) | __lo;
+        return __r;
+    }
+
+    // Every store is a locked instruction, so a plain load is seq_cst.
+    // Without AVX, a failed (or identity) CAS returns the current value.
+    static _Word
+    _S_load(_Word* __p, memory_order) noexcept
+    {
+#ifdef __AVX__
+        typedef long long __v2di __attribute__((__vector_size__(16)));
+        __v2di __v;
+        __asm__ __volatile__("vmovdqa %1, %0"
+                             : "=x"(__v) : "m"(*__p) : "memory");
+        return std::bit_cast<_Word>(__v);
+#else
+        _Word __e = 0;
+        _S_cas(__p, __e, 0);
+        return __e;
+#endif
+    }
+
+    static _Word
+    _S_exchange(_Word* __p, _Word __w, memory_order) noexcept
+    {
+        _Word __e = _S_load(__p, memory_order_relaxed);
+        while (!_S_cas(__p, __e, __w)) { }
+        return __e;
+    }
+
+    static void
+    _S_store(_Word* __p, _Word __w, memory_order __m) noexcept
+    {
+        _S_exchange(__p, __w, __m);
+    }
+
+    static bool
+    _S_compare_exchange(_Word* __p, _Word& __e, _Word __w, bool,
+                        memory_order, memory_order) noexcept
+    {
+        return _S_cas(__p, __e, __w);
+    }
+};
+#endif
+
+// The packed word, with the operations common to atomic_optional and
+// atomic_variant. _Traits supplies _Value, _Word, _S_pack and _S_unpack.
+template<typename _Traits>
+class _Atomic_packed {
+    using _Value = typename _Traits::_Value;
+    using _Word = typename _Traits::_Word;
+    using _Ops = _Word_ops<_Word>;
+
+protected:
+    static constexpr memory_order
+    _S_failure_order(memory_order __m) noexcept
+    {
+        return __m == memory_order_acq_rel ? memory_order_acquire
+               : __m == memory_order_release ? memory_order_relaxed
+               : __m;
+    }
+
+    alignas(sizeof(_Word)) mutable _Word _M_word = 0;
+
+    constexpr _Atomic_packed() noexcept = default;
+
+    explicit
+    _Atomic_packed(const _Value& __v) noexcept
+        : _M_word(_Traits::_S_pack(__v))
+    { }
+
+    bool
+    _M_compare_exchange(_Word& __e, _Word __w, bool __weak,
+                        memory_order __s, memory_order __f) noexcept
+    {
+        return _Ops::_S_compare_exchange(&_M_word, __e, __w, __weak, __s, __f);
+    }
+
+public:
+    static constexpr bool is_always_lock_free = _Ops::_S_lock_free;
+
+    _Atomic_packed(const _Atomic_packed&) = delete;
+    _Atomic_packed& operator=(const _Atomic_packed&) = delete;
+
+    bool
+    is_lock_free() const noexcept
+    {
+        return is_always_lock_free;
+    }
+
+    _Value
+    load(memory_order __m = memory_order_seq_cst) const noexcept
+    {
+        return _Traits::_S_unpack(_Ops::_S_load(&_M_word, __m));
+    }
+
+    operator _Value() const noexcept
+    {
+        return load();
+    }
+
+    void
+    store(const _Value& __v,
+          memory_order __m = memory_order_seq_cst) noexcept
+    {
+        _Ops::_S_store(&_M_word, _Traits::_S_pack(__v), __m);
+    }
+
+    _Value
+    exchange(const _Value& __v,
+             memory_order __m = memory_order_seq_cst) noexcept
+    {
+        return _Traits::_S_unpack(
+                   _Ops::_S_exchange(&_M_word, _Traits::_S_pack(__v), __m));
+    }
+
+    bool
+    compare_exchange_weak(_Value& __e, const _Value& __v,
+                          memory_order __s, memory_order __f) noexcept
+    {
+        _Word __w = _Traits::_S_pack(__e);
+        if (_M_compare_exchange(__w, _Traits::_S_pack(__v), true, __s, __f)) {
+            return true;
+        }
+        __e = _Traits::_S_unpack(__w);
+        return false;
+    }
+
+    bool
+    compare_exchange_weak(_Value& __e, const _Value& __v,
+                          memory_order __m = memory_order_seq_cst) noexcept
+    {
+        return compare_exchange_weak(__e, __v, __m, _S_failure_order(__m));
+    }
+
+    bool
+    compare_exchange_strong(_Value& __e, const _Value& __v,
+                            memory_order __s, memory_order __f) noexcept
+    {
+        _Word __w = _Traits::_S_pack(__e);
+        if (_M_compare_exchange(__w, _Traits::_S_pack(__v), false, __s, __f)) {
+            return true;
+        }
+        __e = _Traits::_S_unpack(__w);
+        return false;
+    }
+
+    bool
+    compare_exchange_strong(_Value& __e, const _Value& __v,
+                            memory_order __m = memory_order_seq_cst) noexcept
+    {
+        return compare_exchange_strong(__e, __v, __m, _S_failure_order(__m));
+    }
+};
+
+template<typename _Tp>
+struct _Optional_traits {
+    static_assert(is_trivially_copyable_v<_Tp>,
+                  "atomic_optional requires a trivially copyable type");
+    static_assert(sizeof(_Tp) + 1 <= 16,
+                  "atomic_optional requires sizeof(T) < 16");
+
+    using _Value = optional<_Tp>;
+    using _Word = __word_t<sizeof(_Tp) + 1>;
+
+    static _Word
+    _S_pack(const _Value& __v) noexcept
+    {
+        _Bytes<_Word> __b{};
+        if (__v) {
+            _Tp __t = *__v;
+            __atomic_value::__clear_padding(__t);
+            __builtin_memcpy(__b._M_b, std::__addressof(__t), sizeof(_Tp));
+            __b._M_b[sizeof(_Tp)] = 1;
+        }
+        return std::bit_cast<_Word>(__b);
+    }
+
+    // A disengaged word has a zero payload. Constructing the result from
+    // it and then resetting it, rather than returning _Value(), leaves no
+    // byte of the result uninitialized for copies of it to read.
+    static _Value
+    _S_unpack(_Word __w) noexcept
+    {
+        auto __b = std::bit_cast<_Bytes<_Word>>(__w);
+        _Bytes<_Tp> __t{};
+        __builtin_memcpy(__t._M_b, __b._M_b, sizeof(_Tp));
+        _Value __v(in_place, std::bit_cast<_Tp>(__t));
+        if (!__b._M_b[sizeof(_Tp)]) {
+            __v.reset();
+        }
+        return __v;
+    }
+};
+
+template<typename... _Types>
+struct _Variant_traits {
+    static_assert((is_trivially_copyable_v<_Types> && ...),
+                  "atomic_variant requires trivially copyable alternatives");
+    static_assert(sizeof...(_Types) < 256);
+
+    static constexpr size_t _S_size = [] {
+        size_t __n = 0;
+        ((__n = sizeof(_Types) > __n ? sizeof(_Types) : __n), ...);
+        return __n;
+    }();
+    static_assert(_S_size + 1 <= 16,
+                  "atomic_variant requires alternatives smaller than 16 bytes");
+
+    using _Value = variant<_Types...>;
+    using _Word = __word_t<_S_size + 1>;
+
+    static _Word
+    _S_pack(const _Value& __v) noexcept
+    {
+        _Bytes<_Word> __b{};
+        std::visit([&__b](const auto& __alt) {
+            auto __t = __alt;
+            __atomic_value::__clear_padding(__t);
+            __builtin_memcpy(__b._M_b, std::__addressof(__t), sizeof(__t));
+        }, __v);
+        __b._M_b[_S_size] = static_cast<unsigned char>(__v.index());
+        return std::bit_cast<_Word>(__b);
+    }
+
+    template<size_t _Np>
+    static _Value
+    _S_unpack_alt(const _Bytes<_Word>& __b) noexcept
+    {
+        using _Tp = variant_alternative_t<_Np, _Value>;
+        _Bytes<_Tp> __t{};
+        __builtin_memcpy(__t._M_b, __b._M_b, sizeof(_Tp));
+        return _Value(in_place_index<_Np>, std::bit_cast<_Tp>(__t));
+    }
+
+    template<size_t... _Ind>
+    static _Value
+    _S_unpack(const _Bytes<_Word>& __b, index_sequence<_Ind...>) noexcept
+    {
+        using _Fn = _Value (*)(const _Bytes<_Word>&) noexcept;
+        static constexpr _Fn __table[] = { &_S_unpack_alt<_Ind>... };
+        return __table[__b._M_b[_S_size]](__b);
+    }
+
+    static _Value
+    _S_unpack(_Word __w) noexcept
+    {
+        return _S_unpack(std::bit_cast<_Bytes<_Word>>(__w),
+                         index_sequence_for<_Types...>());
+    }
+};
+
+} // namespace __atomic_value
+} // namespace __detail
+
+/**
+  * @brief Lock-free atomic holder of a small trivially copyable optional.
+  *
+  * The value is packed into one 1 to 16 byte word, see
+  * __detail::__atomic_value. The default constructed object is disengaged
+  * and constant-initialized.
+  */
+template<typename _Tp>
+class atomic_optional
+    : public __detail::__atomic_value::_Atomic_packed<
+      __detail::__atomic_value::_Optional_traits<_Tp>>
+{
+    using _Traits = __detail::__atomic_value::_Optional_traits<_Tp>;
+    using _Base = __detail::__atomic_value::_Atomic_packed<_Traits>;
+
+public:
+    using value_type = optional<_Tp>;
+
+    constexpr atomic_optional() noexcept = default;
+
+    atomic_optional(const optional<_Tp>& __v) noexcept
+        : _Base(__v)
+    { }
+
+    atomic_optional&
+    operator=(const optional<_Tp>& __v) noexcept
+    {
+        this->store(__v);
+        return *this;
+    }
+
+    void
+    reset(memory_order __m = memory_order_seq_cst) noexcept
+    {
+        this->store(nullopt, __m);
+    }
+
+    // Engages the optional with a _Tp constructed from __args, but only if
+    // it is currently disengaged. Returns whether the value was installed.
+    template<typename... _Args>
+    bool
+    emplace_if_empty(_Args&&... __args) noexcept(
+        is_nothrow_constructible_v<_Tp, _Args...>)
+    {
+        typename _Traits::_Word __e = 0;
+        return this->_M_compare_exchange(
+                   __e, _Traits::_S_pack(optional<_Tp>(
+                           in_place, std::forward<_Args>(__args)...)),
+                   false, memory_order_acq_rel, memory_order_acquire);
+    }
+};
+
+/**
+  * @brief Lock-free atomic holder of a small trivially copyable variant.
+  *
+  * Every alternative must be trivially copyable, and the largest one
+  * smaller than 16 bytes.
+  */
+template<typename... _Types>
+class atomic_variant
+    : public __detail::__atomic_value::_Atomic_packed<
+      __detail::__atomic_value::_Variant_traits<_Types...>>
+{
+    using _Traits = __detail::__atomic_value::_Variant_traits<_Types...>;
+    using _Base = __detail::__atomic_value::_Atomic_packed<_Traits>;
+
+public:
+    using value_type = variant<_Types...>;
+
+    // Holds a value-initialized first alternative, like variant.
+    atomic_variant() noexcept
+        : _Base(variant<_Types...>())
+    { }
+
+    atomic_variant(const variant<_Types...>& __v) noexcept
+        : _Base(__v)
+    { }
+
+    atomic_variant&
+    operator=(const variant<_Types...>& __v) noexcept
+    {
+        this->store(__v);
+        return *this;
+    }
+};
+
+_GLIBCXX_END_NAMESPACE_VERSION
+} // namespace std
+
+#endif // C++20
+
+#endif // _GLIBCXX_ATOMIC_OPTIONAL_VARIANT
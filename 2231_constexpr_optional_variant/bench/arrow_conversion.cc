@@ -0,0 +1,171 @@
+// Conversion throughput between spans of optionals or variants and Arrow
+// arrays.
+//
+// N elements of optional<double> (one in seven empty) and of
+// variant<int64_t, double> are converted three ways:
+//
+//  - copy: the per-element loop an exporter would otherwise write, pushing
+//    values and type ids into vectors and setting validity bits.
+//  - export: export_optional_array or export_variant_array, dense and
+//    sparse, including allocating the Arrow buffers and releasing them.
+//  - import: wrapping the exported array in arrow_optional_array or
+//    arrow_union_array and reading every element.
+//
+// Prints the best of seven runs of each, in GB/s of the input span.
+//
+//   g++ -std=c++20 -O2 -I.. arrow_conversion.cc && ./a.out
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <vector>
+#include "../arrow_optional_variant.h"
+
+#ifndef N
+# define N 10000000
+#endif
+
+using Clock = std::chrono::steady_clock;
+
+using V = std::variant<std::int64_t, double>;
+
+template<typename _Fn>
+double
+best(_Fn f)
+{
+    double b = 1e9;
+    for (int k = 0; k < 7; ++k) {
+        auto t0 = Clock::now();
+        f();
+        b = std::min(b, std::chrono::duration<double>(Clock::now() - t0)
+                            .count());
+    }
+    return b;
+}
+
+template<typename _Tp>
+void
+keep(const _Tp* p)
+{
+    asm volatile("" : : "r"(p) : "memory");
+}
+
+double
+optionals()
+{
+    std::vector<std::optional<double>> in(N);
+    for (long i = 0; i < N; ++i) {
+        if (i % 7) {
+            in[i] = i * 0.5;
+        }
+    }
+    std::span<const std::optional<double>> values(in);
+    const double bytes = N * sizeof(std::optional<double>);
+
+    double copy = best([&] {
+        std::vector<double> v;
+        std::vector<std::uint8_t> bits((N + 7) / 8);
+        v.reserve(N);
+        for (long i = 0; i < N; ++i) {
+            if (in[i]) {
+                v.push_back(*in[i]);
+                bits[i / 8] |= 1 << (i % 8);
+            } else {
+                v.push_back(0);
+            }
+        }
+        keep(v.data());
+        keep(bits.data());
+    });
+    double exp = best([&] {
+        ArrowArray a;
+        ArrowSchema s;
+        std::export_optional_array(values, &a, &s);
+        a.release(&a);
+        s.release(&s);
+    });
+    ArrowArray a;
+    ArrowSchema s;
+    std::export_optional_array(values, &a, &s);
+    double sum = 0;
+    double imp = best([&] {
+        std::arrow_optional_array<double> out(a, s);
+        for (size_t i = 0; i < out.size(); ++i) {
+            sum += out[i].value_or(0.0);
+        }
+    });
+    a.release(&a);
+    s.release(&s);
+    std::printf("%-30s copy %5.2f  export %5.2f  import %5.2f GB/s\n",
+                "optional<double>", bytes / copy / 1e9, bytes / exp / 1e9,
+                bytes / imp / 1e9);
+    return sum;
+}
+
+double
+variants()
+{
+    std::vector<V> in(N);
+    for (long i = 0; i < N; ++i) {
+        if (i % 3) {
+            in[i] = i * 0.5;
+        } else {
+            in[i] = std::int64_t(i);
+        }
+    }
+    std::span<const V> values(in);
+    const double bytes = N * sizeof(V);
+
+    double copy = best([&] {
+        std::vector<std::int8_t> ids;
+        std::vector<std::int32_t> offsets;
+        std::vector<std::int64_t> ints;
+        std::vector<double> doubles;
+        for (const V& v : in) {
+            ids.push_back(std::int8_t(v.index()));
+            if (v.index() == 0) {
+                offsets.push_back(std::int32_t(ints.size()));
+                ints.push_back(std::get<0>(v));
+            } else {
+                offsets.push_back(std::int32_t(doubles.size()));
+                doubles.push_back(std::get<1>(v));
+            }
+        }
+        keep(ids.data());
+        keep(ints.data());
+    });
+    double sum = 0;
+    for (auto mode : { std::arrow_union_mode::dense,
+                       std::arrow_union_mode::sparse }) {
+        double exp = best([&] {
+            ArrowArray a;
+            ArrowSchema s;
+            std::export_variant_array(values, &a, &s, mode);
+            a.release(&a);
+            s.release(&s);
+        });
+        ArrowArray a;
+        ArrowSchema s;
+        std::export_variant_array(values, &a, &s, mode);
+        double imp = best([&] {
+            std::arrow_union_array<std::int64_t, double> out(a, s);
+            for (size_t i = 0; i < out.size(); ++i) {
+                sum += std::visit([](auto x) { return double(x); }, out[i]);
+            }
+        });
+        a.release(&a);
+        s.release(&s);
+        std::printf("%-30s copy %5.2f  export %5.2f  import %5.2f GB/s\n",
+                    mode == std::arrow_union_mode::dense
+                        ? "variant<int64, double> dense"
+                        : "variant<int64, double> sparse",
+                    bytes / copy / 1e9, bytes / exp / 1e9, bytes / imp / 1e9);
+    }
+    return sum;
+}
+
+int
+main()
+{
+    return optionals() + variants() == 0;
+}
@@ -0,0 +1,203 @@
+// Throughput of atomic_optional and atomic_variant under contention,
+// against the same values behind a std::mutex.
+//
+// For each thread count given (default 1 2 4 8 16 32 64), all threads hit
+// one object for MS milliseconds with one of three operations:
+//
+//  - store: stores a value derived from the iteration;
+//  - exchange: swaps one in and uses the old value;
+//  - cas: increments the value with a compare_exchange_weak loop, and the
+//    total is checked against the number of increments at the end.
+//
+// Prints the total operations per second. The values are an optional of a
+// 4 and of a 12 byte struct (8 and 16 byte words) and a variant<int, float>.
+//
+//   g++ -std=c++20 -O2 -pthread -I.. atomic_contention.cc && ./a.out
+//   g++ -std=c++20 -O2 -pthread -mavx -I.. atomic_contention.cc && ./a.out
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+#include "../atomic_optional_variant.h"
+
+#ifndef MS
+# define MS 200
+#endif
+
+struct Small {
+    int value;
+
+    bool operator==(const Small&) const = default;
+};
+
+struct Large {
+    int value;
+    int pad[2];
+
+    bool operator==(const Large&) const = default;
+};
+
+using Small_opt = std::optional<Small>;
+using Large_opt = std::optional<Large>;
+using Number = std::variant<int, float>;
+
+// The value after v, and the count it holds.
+template<typename _Tp>
+std::optional<_Tp>
+next(const std::optional<_Tp>& v)
+{
+    _Tp t{};
+    t.value = v ? v->value + 1 : 1;
+    return t;
+}
+
+template<typename _Tp>
+long
+count(const std::optional<_Tp>& v)
+{
+    return v ? v->value : 0;
+}
+
+Number
+next(const Number& v)
+{
+    return std::get<int>(v) + 1;
+}
+
+long
+count(const Number& v)
+{
+    return std::get<int>(v);
+}
+
+// The operations of atomic_optional and atomic_variant, under a mutex.
+template<typename _Value>
+struct Locked {
+    using value_type = _Value;
+
+    mutable std::mutex mutex;
+    _Value value{};
+
+    _Value
+    load() const
+    {
+        std::lock_guard lock(mutex);
+        return value;
+    }
+
+    void
+    store(const _Value& v)
+    {
+        std::lock_guard lock(mutex);
+        value = v;
+    }
+
+    _Value
+    exchange(const _Value& v)
+    {
+        std::lock_guard lock(mutex);
+        return std::exchange(value, v);
+    }
+
+    bool
+    compare_exchange_weak(_Value& e, const _Value& v)
+    {
+        std::lock_guard lock(mutex);
+        if (value == e) {
+            value = v;
+            return true;
+        }
+        e = value;
+        return false;
+    }
+};
+
+enum Op { STORE, EXCHANGE, CAS };
+
+template<typename _Atomic>
+long
+hammer(_Atomic& a, Op op, const std::atomic<bool>& stop)
+{
+    using _Value = typename _Atomic::value_type;
+    long n = 0;
+    long sink = 0;
+    _Value v{};
+    for (; !stop.load(std::memory_order_relaxed); ++n) {
+        switch (op) {
+        case STORE:
+            v = next(v);
+            a.store(v);
+            break;
+        case EXCHANGE:
+            v = next(v);
+            sink += count(a.exchange(v));
+            break;
+        case CAS: {
+            _Value e = a.load();
+            while (!a.compare_exchange_weak(e, next(e))) { }
+            break;
+        }
+        }
+    }
+    return n + (sink & 0);
+}
+
+template<typename _Atomic>
+double
+run(Op op, int threads)
+{
+    _Atomic a;
+    a.store(typename _Atomic::value_type{});
+    std::atomic<bool> stop{false};
+    std::atomic<long> ops{0};
+    std::vector<std::thread> workers;
+    for (int t = 0; t < threads; ++t) {
+        workers.emplace_back([&] { ops += hammer(a, op, stop); });
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(MS));
+    stop = true;
+    for (auto& t : workers) {
+        t.join();
+    }
+    if (op == CAS && count(a.load()) != ops) {
+        std::printf("lost increments: %ld of %ld\n", ops - count(a.load()),
+                    long(ops));
+        std::exit(1);
+    }
+    return ops / (MS * 1e3);
+}
+
+template<typename _Value, typename _Atomic>
+void
+compare(const char* name, int threads)
+{
+    static const char* const ops[] = { "store", "exchange", "cas" };
+    for (Op op : { STORE, EXCHANGE, CAS }) {
+        std::printf("%-16s %-8s %2d threads: atomic %7.1f  mutex %7.1f"
+                    " M ops/s\n", name, ops[op], threads,
+                    run<_Atomic>(op, threads),
+                    run<Locked<_Value>>(op, threads));
+    }
+}
+
+int
+main(int argc, char** argv)
+{
+    std::vector<int> counts;
+    for (int i = 1; i < argc; ++i) {
+        counts.push_back(std::atoi(argv[i]));
+    }
+    if (counts.empty()) {
+        counts = { 1, 2, 4, 8, 16, 32, 64 };
+    }
+    for (int n : counts) {
+        compare<Small_opt, std::atomic_optional<Small>>("optional<4 B>", n);
+        compare<Large_opt, std::atomic_optional<Large>>("optional<12 B>", n);
+        compare<Number, std::atomic_variant<int, float>>("variant", n);
+    }
+}
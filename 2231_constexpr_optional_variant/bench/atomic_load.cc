@@ -0,0 +1,77 @@
+// Cost of atomic_optional::load for an 8 byte and a 16 byte word.
+//
+// Each of the given number of threads (default 1) loads the same object
+// LOADS times, and the wall time per load of one thread is printed. With
+// more than one thread this shows whether the readers contend: a 16 byte
+// load built without AVX is a cmpxchg16b, which takes the cache line
+// exclusive.
+//
+//   g++ -std=c++20 -O2 -pthread -I.. atomic_load.cc && ./a.out
+//   g++ -std=c++20 -O2 -pthread -mavx -I.. atomic_load.cc && ./a.out 4
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <thread>
+#include <vector>
+#include "../atomic_optional_variant.h"
+
+#ifndef LOADS
+# define LOADS 100000000
+#endif
+
+// 4 and 12 bytes: words of 8 and 16 bytes.
+struct Small {
+    int value;
+};
+
+struct Large {
+    int value;
+    int pad[2];
+};
+
+template<typename _Tp>
+std::atomic_optional<_Tp> object;
+
+template<typename _Tp>
+void
+read()
+{
+    long sum = 0;
+    for (long i = 0; i < LOADS; ++i) {
+        auto v = object<_Tp>.load();
+        sum += v ? v->value : 0;
+    }
+    if (sum != long(LOADS)) {
+        std::abort();
+    }
+}
+
+template<typename _Tp>
+void
+run(const char* name, int threads)
+{
+    _Tp one{};
+    one.value = 1;
+    object<_Tp>.store(one);
+    auto start = std::chrono::steady_clock::now();
+    std::vector<std::thread> readers;
+    for (int i = 0; i < threads; ++i) {
+        readers.emplace_back(read<_Tp>);
+    }
+    for (auto& t : readers) {
+        t.join();
+    }
+    std::chrono::duration<double, std::nano> d
+        = std::chrono::steady_clock::now() - start;
+    std::printf("%-8s %2zu byte word, %d threads: %6.2f ns/load\n", name,
+                sizeof(object<_Tp>), threads, d.count() / LOADS);
+}
+
+int
+main(int argc, char** argv)
+{
+    int threads = argc > 1 ? std::atoi(argv[1]) : 1;
+    run<Small>("Small", threads);
+    run<Large>("Large", threads);
+}
@@ -0,0 +1,91 @@
+// Compile-time cost of visit during constant evaluation.
+//
+// Each static_assert below visits variants VISITS times inside one
+// constant evaluation. Build with -fsyntax-only and time it, and find the
+// constexpr operation count by lowering -fconstexpr-ops-limit until the
+// build fails (bench/constexpr_visit.sh does both):
+//
+//   g++ -std=c++20 -fsyntax-only -I.. -DALTS=48 -DARITY=1 constexpr_visit.cc
+//   g++ -std=c++20 -fsyntax-only -I.. -DALTS=24 -DARITY=3 constexpr_visit.cc
+//
+// ALTS is the number of alternatives of each variant and ARITY the number
+// of variants passed to one visit call (1 to 3).
+
+#include <array>
+#include <utility>
+#include "../fixed_variant.h"
+
+#ifndef ALTS
+# define ALTS 48
+#endif
+#ifndef ARITY
+# define ARITY 1
+#endif
+#ifndef VISITS
+# define VISITS 1000
+#endif
+
+template<std::size_t _Np>
+struct Alt {
+    int value;
+};
+
+template<std::size_t... _Is>
+auto make_variant(std::index_sequence<_Is...>) -> std::variant<Alt<_Is>...>;
+
+using V = decltype(make_variant(std::make_index_sequence<ALTS>{}));
+
+// One variant holding each alternative, so that the loop below selects
+// alternatives without any extra dispatch of its own.
+template<std::size_t... _Is>
+constexpr std::array<V, ALTS>
+make_all(std::index_sequence<_Is...>)
+{
+    return { V(std::in_place_index<_Is>, Alt<_Is>{int(_Is)})... };
+}
+
+constexpr long
+run()
+{
+    constexpr auto __all = make_all(std::make_index_sequence<ALTS>{});
+    long __sum = 0;
+    for (int __i = 0; __i < VISITS; ++__i) {
+        const V& __a = __all[__i % ALTS];
+#if ARITY == 1
+        __sum += std::visit([](const auto& __x) { return __x.value; }, __a);
+#elif ARITY == 2
+        const V& __b = __all[(__i * 7) % ALTS];
+        __sum += std::visit([](const auto& __x, const auto& __y) {
+            return __x.value + __y.value;
+        }, __a, __b);
+#else
+        const V& __b = __all[(__i * 7) % ALTS];
+        const V& __c = __all[(__i * 13) % ALTS];
+        __sum += std::visit([](const auto& __x, const auto& __y,
+                               const auto& __z) {
+            return __x.value + __y.value + __z.value;
+        }, __a, __b, __c);
+#endif
+    }
+    return __sum;
+}
+
+constexpr long
+expected()
+{
+    long __sum = 0;
+    for (int __i = 0; __i < VISITS; ++__i) {
+        __sum += __i % ALTS;
+#if ARITY >= 2
+        __sum += (__i * 7) % ALTS;
+#endif
+#if ARITY >= 3
+        __sum += (__i * 13) % ALTS;
+#endif
+    }
+    return __sum;
+}
+
+static_assert(run() == expected());
+
+int main() { }
@@ -0,0 +1,44 @@
+#!/bin/sh
+# Compile time and constexpr operation count of constexpr_visit.cc.
+#
+#   bench/constexpr_visit.sh [g++ options...]
+#
+# For each configuration, prints the time of one -fsyntax-only build and,
+# for the single and binary visits, the smallest -fconstexpr-ops-limit that
+# still compiles, found by bisection to within 0.5%. The ternary visit is
+# dominated by instantiating its 24^3 combinations and is only timed.
+
+cd "$(dirname "$0")" || exit 1
+CXX=${CXX:-g++}
+
+try() {
+    $CXX "$@" -fsyntax-only -I.. constexpr_visit.cc 2>/dev/null
+}
+
+ops() {
+    lo=0; hi=1000000
+    while ! try "$@" -fconstexpr-ops-limit=$hi; do
+        lo=$hi; hi=$((hi * 2))
+    done
+    while [ $((hi - lo)) -gt $((hi / 200)) ]; do
+        mid=$(((lo + hi) / 2))
+        if try "$@" -fconstexpr-ops-limit=$mid; then
+            hi=$mid
+        else
+            lo=$mid
+        fi
+    done
+    echo $hi
+}
+
+for cfg in "-DALTS=48 -DARITY=1" "-DALTS=24 -DARITY=2" "-DALTS=24 -DARITY=3"; do
+    start=$(date +%s.%N)
+    try -std=c++20 "$@" $cfg || { echo "$cfg: build failed"; exit 1; }
+    end=$(date +%s.%N)
+    case $cfg in
+    *ARITY=3) n=- ;;
+    *) n=$(ops -std=c++20 "$@" $cfg) ;;
+    esac
+    awk -v c="$cfg" -v s="$start" -v e="$end" -v n="$n" \
+        'BEGIN { printf "%-22s %7.2f s  %10s ops\n", c, e - s, n }'
+done
@@ -0,0 +1,64 @@
+// Compile-time cost of selecting the alternative for variant's converting
+// constructor and assignment.
+//
+// A variant of ALTS alternatives is constructed and assigned from SOURCES
+// distinct source types. With CONVERT=0 each source is one of the
+// alternatives; with CONVERT=1 it is a class that converts to exactly one
+// of them, so the selection needs overload resolution over the imaginary
+// FUN(T_i) set. Build with -fsyntax-only and time it (bench/converting_ctor.sh
+// sweeps both counts):
+//
+//   g++ -std=c++20 -fsyntax-only -I.. -DALTS=64 -DSOURCES=64 converting_ctor.cc
+
+#include <utility>
+#include "fixed_variant.h"
+
+#ifndef ALTS
+# define ALTS 64
+#endif
+#ifndef SOURCES
+# define SOURCES ALTS
+#endif
+#ifndef CONVERT
+# define CONVERT 0
+#endif
+
+template<std::size_t _Np>
+struct Alt {
+    int value;
+};
+
+template<std::size_t _Np>
+struct Src {
+    operator Alt<_Np % ALTS>() const { return { int(_Np) }; }
+};
+
+template<std::size_t... _Is>
+auto make_variant(std::index_sequence<_Is...>) -> std::variant<Alt<_Is>...>;
+
+using V = decltype(make_variant(std::make_index_sequence<ALTS>{}));
+
+template<std::size_t _Jp>
+using Source = std::conditional_t<CONVERT, Src<_Jp>, Alt<_Jp % ALTS>>;
+
+template<std::size_t _Jp>
+std::size_t
+use()
+{
+    V v(Source<_Jp>{});
+    v = Source<_Jp>{};
+    return v.index();
+}
+
+template<std::size_t... _Js>
+std::size_t
+use_all(std::index_sequence<_Js...>)
+{
+    return (use<_Js>() + ...);
+}
+
+std::size_t
+total()
+{
+    return use_all(std::make_index_sequence<SOURCES>{});
+}
@@ -0,0 +1,39 @@
+#!/bin/sh
+# Compile time of converting_ctor.cc over a range of alternative and source
+# type counts, built against each header directory given (default: the
+# headers in this tree).
+#
+#   bench/converting_ctor.sh [include-dir...]
+#
+# For each directory, number of alternatives and number of source types,
+# prints the time of one -fsyntax-only build with sources that are
+# alternatives (exact) and with sources that convert to one (convert).
+
+cd "$(dirname "$0")" || exit 1
+CXX=${CXX:-g++}
+
+# Prints the seconds taken by one build with the given options.
+build() {
+    start=$(date +%s.%N)
+    $CXX -std=c++20 -fsyntax-only -w "$@" converting_ctor.cc || return 1
+    end=$(date +%s.%N)
+    awk -v s="$start" -v e="$end" 'BEGIN { print e - s }'
+}
+
+[ $# -gt 0 ] || set -- ..
+for dir in "$@"; do
+    echo "$dir"
+    for alts in 16 32 64 128; do
+        for sources in 16 64 128; do
+            [ $sources -le $alts ] || continue
+            cfg="-I$dir -DALTS=$alts -DSOURCES=$sources"
+            exact=$(build $cfg -DCONVERT=0) \
+                || { echo "$cfg: build failed"; exit 1; }
+            convert=$(build $cfg -DCONVERT=1) \
+                || { echo "$cfg: build failed"; exit 1; }
+            awk -v a="$alts" -v s="$sources" -v x="$exact" -v c="$convert" \
+                'BEGIN { printf "  %3d alternatives %3d sources:" \
+                         "  exact %6.2f s  convert %6.2f s\n", a, s, x, c }'
+        done
+    done
+done
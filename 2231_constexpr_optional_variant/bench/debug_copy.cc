@@ -0,0 +1,141 @@
+// Call depth and run time of variant and optional copies, for comparing
+// debug (-O0, -Og) with release builds.
+//
+// The depth is the number of library frames between the function that
+// copies, moves or assigns a variant<int, Probe> or optional<Probe> and the
+// special member of Probe that it ends up calling, counted with backtrace.
+// The time is for the same operations on variant<int, std::string> and
+// optional<std::string> holding a short string, so that the string itself
+// costs little and the layers around it dominate. Each operation is in a
+// function of its own, which is not inlined into the timing loop. Prints
+// the best of five runs of ITERS operations. bench/debug_copy.sh builds
+// this at each optimization level against each header directory given.
+//
+//   g++ -std=c++20 -O0 -I.. debug_copy.cc && ./a.out
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <execinfo.h>
+#include <string>
+#include "fixed_optional.h"
+#include "fixed_variant.h"
+
+#ifndef ITERS
+# define ITERS 2000000
+#endif
+
+using Clock = std::chrono::steady_clock;
+
+__attribute__((noinline)) int
+frames()
+{
+    void* buf[64];
+    return backtrace(buf, 64);
+}
+
+// The depth of the last special member of Probe that ran.
+static int probed;
+
+struct Probe {
+    Probe() = default;
+
+    Probe(const Probe&) { probed = frames(); }
+
+    Probe(Probe&&) noexcept { probed = frames(); }
+
+    Probe&
+    operator=(const Probe&)
+    {
+        probed = frames();
+        return *this;
+    }
+
+    Probe&
+    operator=(Probe&&) noexcept
+    {
+        probed = frames();
+        return *this;
+    }
+
+    ~Probe() { }
+};
+
+// Frames strictly between the caller of _Op and the special member.
+template<typename _Tp, void (*_Op)(_Tp&, _Tp&)>
+__attribute__((noinline)) int
+depth(const _Tp& v)
+{
+    _Tp a(v), b(v);
+    int base = frames();
+    _Op(a, b);
+    return probed - base - 1;
+}
+
+template<typename _Tp>
+__attribute__((noinline)) void
+copy(_Tp&, _Tp& s)
+{
+    _Tp c(s);
+}
+
+template<typename _Tp>
+__attribute__((noinline)) void
+move(_Tp&, _Tp& s)
+{
+    _Tp c(std::move(s));
+}
+
+template<typename _Tp>
+__attribute__((noinline)) void
+copy_assign(_Tp& d, _Tp& s)
+{
+    d = s;
+}
+
+template<typename _Tp>
+__attribute__((noinline)) void
+move_assign(_Tp& d, _Tp& s)
+{
+    d = std::move(s);
+}
+
+template<typename _Tp, void (*_Op)(_Tp&, _Tp&)>
+double
+time(const _Tp& v)
+{
+    double best = 1e9;
+    for (int k = 0; k < 5; ++k) {
+        _Tp a(v), b(v);
+        auto t0 = Clock::now();
+        for (int i = 0; i < ITERS; ++i) {
+            _Op(a, b);
+        }
+        std::chrono::duration<double, std::nano> d = Clock::now() - t0;
+        best = std::min(best, d.count() / ITERS);
+    }
+    return best;
+}
+
+template<typename _Probe, typename _String>
+void
+run(const char* name, const _Probe& p, const _String& v)
+{
+    std::printf("%-8s  copy %2d %6.1f ns  move %2d %6.1f ns"
+                "  copy= %2d %6.1f ns  move= %2d %6.1f ns\n", name,
+                depth<_Probe, copy>(p), time<_String, copy>(v),
+                depth<_Probe, move>(p), time<_String, move>(v),
+                depth<_Probe, copy_assign>(p), time<_String, copy_assign>(v),
+                depth<_Probe, move_assign>(p), time<_String, move_assign>(v));
+}
+
+int
+main()
+{
+    using Variant = std::variant<int, Probe>;
+    using String_variant = std::variant<int, std::string>;
+    run("variant", Variant(std::in_place_index<1>),
+        String_variant(std::in_place_index<1>, "short"));
+    run("optional", std::optional<Probe>(std::in_place),
+        std::optional<std::string>(std::in_place, "short"));
+}
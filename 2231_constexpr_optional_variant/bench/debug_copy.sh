@@ -0,0 +1,24 @@
+#!/bin/sh
+# Call depth and run time of debug_copy.cc at -O0, -Og and -O2, built
+# against each header directory given (default: the headers in this tree).
+#
+#   bench/debug_copy.sh [include-dir...]
+#
+# Each line gives, for copy and move construction and assignment, the
+# frames between the caller and the alternative's special member and the
+# time of one operation.
+
+cd "$(dirname "$0")" || exit 1
+CXX=${CXX:-g++}
+out=$(mktemp) || exit 1
+trap 'rm -f "$out"' EXIT
+
+[ $# -gt 0 ] || set -- ..
+for dir in "$@"; do
+    echo "$dir"
+    for opt in -O0 -Og -O2; do
+        $CXX -std=c++20 $opt -w -I"$dir" -o "$out" debug_copy.cc \
+            || { echo "$dir $opt: build failed"; exit 1; }
+        "$out" | sed "s/^/  $opt /"
+    done
+done
@@ -0,0 +1,150 @@
+// Memory and throughput of a vector of variants whose one large, rare
+// alternative is stored inline or boxed in indirect<T>.
+//
+// The variant holds an integer, a double, a 16 byte point, or, one element
+// in RARE, a 256 byte record. Inline, every element is as large as the
+// record; boxed, the elements are 24 bytes and each record is a separate
+// pool block. For both layouts, N elements are built by push_back, then
+// scanned (visit summing a number from each), then the vector is copied.
+// Prints the bytes used, counted by replacing the global operator new, and
+// the best of five runs of each phase.
+//
+//   g++ -std=c++20 -O2 -I.. indirect_vector.cc && ./a.out
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+#include <vector>
+#include "../indirect.h"
+
+#ifndef N
+# define N 1000000
+#endif
+#ifndef RARE
+# define RARE 64
+#endif
+
+using Clock = std::chrono::steady_clock;
+
+static long allocated;
+
+void*
+operator new(std::size_t n)
+{
+    allocated += long(n);
+    if (void* p = std::malloc(n ? n : 1)) {
+        return p;
+    }
+    throw std::bad_alloc();
+}
+
+void operator delete(void* p) noexcept { std::free(p); }
+
+void operator delete(void* p, std::size_t n) noexcept
+{
+    allocated -= long(n);
+    std::free(p);
+}
+
+struct Point {
+    double x, y;
+};
+
+struct Record {
+    long fields[32];
+};
+
+using Inline = std::variant<long, double, Point, Record>;
+using Boxed = std::variant<long, double, Point, std::indirect<Record>>;
+
+template<typename _Value>
+_Value
+make(long i)
+{
+    if (i % RARE == 0) {
+        Record r;
+        std::fill(r.fields, r.fields + 32, i);
+        return _Value(std::in_place_index<3>, r);
+    }
+    switch (i % 3) {
+    case 0: return _Value(std::in_place_index<0>, i);
+    case 1: return _Value(std::in_place_index<1>, double(i));
+    default: return _Value(std::in_place_index<2>, Point{double(i), 1.0});
+    }
+}
+
+struct Number {
+    long operator()(long l) const { return l; }
+
+    long operator()(double d) const { return long(d); }
+
+    long operator()(const Point& p) const { return long(p.x); }
+
+    long operator()(const Record& r) const { return r.fields[31]; }
+
+    long
+    operator()(const std::indirect<Record>& r) const
+    {
+        return r->fields[31];
+    }
+};
+
+template<typename _Value>
+__attribute__((noinline)) long
+scan(const std::vector<_Value>& v)
+{
+    long sum = 0;
+    for (const _Value& e : v) {
+        sum += std::visit(Number{}, e);
+    }
+    return sum;
+}
+
+double
+ms(Clock::time_point a, Clock::time_point b)
+{
+    return std::chrono::duration<double, std::milli>(b - a).count();
+}
+
+template<typename _Value>
+long
+run(const char* name)
+{
+    double best[3] = { 1e9, 1e9, 1e9 };
+    long bytes = 0;
+    long sum = 0;
+    for (int k = 0; k < 5; ++k) {
+        long before = allocated;
+        auto t0 = Clock::now();
+        std::vector<_Value> v;
+        for (long i = 0; i < N; ++i) {
+            v.push_back(make<_Value>(i));
+        }
+        auto t1 = Clock::now();
+        v.shrink_to_fit();
+        bytes = allocated - before;
+        auto t2 = Clock::now();
+        sum = scan(v);
+        auto t3 = Clock::now();
+        std::vector<_Value> copy(v);
+        auto t4 = Clock::now();
+        double d[] = { ms(t0, t1), ms(t2, t3), ms(t3, t4) };
+        for (int i = 0; i < 3; ++i) {
+            best[i] = std::min(best[i], d[i]);
+        }
+    }
+    std::printf("%-7s %3zu byte elements, %7.1f MB  build %7.2f ms"
+                "  scan %6.2f ms  copy %7.2f ms\n", name, sizeof(_Value),
+                bytes / 1e6, best[0], best[1], best[2]);
+    return sum;
+}
+
+int
+main()
+{
+    long a = run<Inline>("inline");
+    long b = run<Boxed>("boxed");
+    return a != b;
+}
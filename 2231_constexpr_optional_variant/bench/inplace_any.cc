@@ -0,0 +1,141 @@
+// inplace_any against std::any and unique_ptr to a polymorphic base.
+//
+// N 24 byte payloads, past std::any's small buffer, are stored in a vector
+// of each kind. Prints the size of one element and, per element, the best
+// of five runs of: creating it by push_back, reading a field through
+// any_cast or a virtual call, move-assigning the whole vector element by
+// element, and copy-assigning it (clone() for unique_ptr). Also prints the
+// allocations per element created, counted by replacing operator new.
+//
+//   g++ -std=c++20 -O2 -I.. inplace_any.cc && ./a.out
+
+#include <algorithm>
+#include <any>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <new>
+#include <vector>
+#include "../inplace_any.h"
+
+#ifndef N
+# define N 1000000
+#endif
+
+using Clock = std::chrono::steady_clock;
+
+static long allocations;
+
+void*
+operator new(std::size_t n)
+{
+    ++allocations;
+    if (void* p = std::malloc(n ? n : 1)) {
+        return p;
+    }
+    throw std::bad_alloc();
+}
+
+void operator delete(void* p) noexcept { std::free(p); }
+
+void operator delete(void* p, std::size_t) noexcept { std::free(p); }
+
+struct Payload {
+    long id;
+    double x, y;
+};
+
+struct Base {
+    virtual ~Base() = default;
+
+    virtual long id() const = 0;
+
+    virtual std::unique_ptr<Base> clone() const = 0;
+};
+
+struct Derived : Base {
+    Payload p;
+
+    explicit Derived(Payload q) : p(q) { }
+
+    long id() const override { return p.id; }
+
+    std::unique_ptr<Base>
+    clone() const override
+    {
+        return std::make_unique<Derived>(*this);
+    }
+};
+
+using Inplace = std::inplace_any<32, 8>;
+
+// Nanoseconds per element, best of five.
+template<typename _Fn>
+double
+per_element(_Fn f)
+{
+    double best = 1e9;
+    for (int k = 0; k < 5; ++k) {
+        auto t0 = Clock::now();
+        f();
+        best = std::min(best, std::chrono::duration<double, std::nano>(
+                                  Clock::now() - t0).count() / N);
+    }
+    return best;
+}
+
+template<typename _Tp, typename _Make, typename _Get, typename _Copy>
+long
+run(const char* name, _Make make, _Get get, _Copy copy)
+{
+    std::vector<_Tp> v, moved(N), copied(N);
+    v.reserve(N);
+    long before = allocations;
+    double create = per_element([&] {
+        v.clear();
+        for (long i = 0; i < N; ++i) {
+            v.push_back(make(Payload{i, 1.0, 2.0}));
+        }
+    });
+    long per = (allocations - before) / 5 / N;
+    long sum = 0;
+    double read = per_element([&] {
+        for (const _Tp& e : v) {
+            sum += get(e);
+        }
+    });
+    double move = per_element([&] {
+        for (long i = 0; i < N; ++i) {
+            moved[i] = std::move(v[i]);
+        }
+        v.swap(moved);
+    });
+    double copy_assign = per_element([&] {
+        for (long i = 0; i < N; ++i) {
+            copied[i] = copy(v[i]);
+        }
+    });
+    std::printf("%-18s %3zu bytes  create %5.1f  read %5.2f  move %5.1f"
+                "  copy %5.1f ns  %ld allocations\n", name, sizeof(_Tp),
+                create, read, move, copy_assign, per);
+    return sum;
+}
+
+int
+main()
+{
+    long a = run<Inplace>("inplace_any<32, 8>",
+        [](Payload p) { return Inplace(p); },
+        [](const Inplace& e) { return std::any_cast<Payload>(&e)->id; },
+        [](const Inplace& e) { return e; });
+    long b = run<std::any>("std::any",
+        [](Payload p) { return std::any(p); },
+        [](const std::any& e) { return std::any_cast<Payload>(&e)->id; },
+        [](const std::any& e) { return e; });
+    long c = run<std::unique_ptr<Base>>("unique_ptr<Base>",
+        [](Payload p) { return std::unique_ptr<Base>(new Derived(p)); },
+        [](const std::unique_ptr<Base>& e) { return e->id(); },
+        [](const std::unique_ptr<Base>& e) { return e->clone(); });
+    return a != b || b != c;
+}
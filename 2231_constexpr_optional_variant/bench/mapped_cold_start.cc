@@ -0,0 +1,203 @@
+// Cold start of mapped_array against reading and parsing the whole file.
+//
+// N records of variant<int64_t, double, string> are serialized to a file
+// (argument 1, default /tmp/mapped_cold_start.bin). Each case then runs in
+// a fresh child process, once with the file evicted from the page cache
+// (posix_fadvise DONTNEED) and once with it cached:
+//
+//  - parse: read the file, deserialize it into a vector<variant> and access
+//    the middle record.
+//  - open: construct a mapped_array and access the middle record.
+//  - sample: open, then visit every 1000th record.
+//  - scan: open with sequential advice, then visit every record.
+//
+// Prints the time from the start of the case until it is done, and the
+// growth of the child's resident set over it. For the mapped cases that
+// is page cache shared with every other reader of the file.
+//
+//   g++ -std=c++20 -O2 -I.. mapped_cold_start.cc && ./a.out
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fcntl.h>
+#include <string>
+#include <sys/wait.h>
+#include <unistd.h>
+#include <vector>
+#include "../mapped_optional_variant.h"
+
+#ifndef N
+# define N 10000000
+#endif
+
+using Clock = std::chrono::steady_clock;
+
+using V = std::variant<std::int64_t, double, std::string>;
+
+// Set by each case before it releases its data.
+static long resident_kb;
+
+long
+rss_kb()
+{
+    FILE* f = std::fopen("/proc/self/status", "r");
+    char line[256];
+    long kb = -1;
+    while (f && std::fgets(line, sizeof line, f)) {
+        if (std::strncmp(line, "VmRSS:", 6) == 0) {
+            kb = std::atol(line + 6);
+        }
+    }
+    if (f) {
+        std::fclose(f);
+    }
+    return kb;
+}
+
+void
+write_file(const char* path)
+{
+    std::vector<V> in;
+    in.reserve(N);
+    for (long i = 0; i < N; ++i) {
+        switch (i % 3) {
+        case 0: in.emplace_back(std::int64_t(i)); break;
+        case 1: in.emplace_back(i * 0.5); break;
+        default: in.emplace_back("value " + std::to_string(i)); break;
+        }
+    }
+    std::span<const V> values(in);
+    const size_t n = std::serialized_size(values);
+    auto* buf = static_cast<std::byte*>(
+                    std::aligned_alloc(64, (n + 63) / 64 * 64));
+    std::serialize(values, std::span<std::byte>(buf, n));
+    int fd = ::open(path, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (fd < 0 || ::write(fd, buf, n) != ssize_t(n) || ::fsync(fd) != 0) {
+        std::perror(path);
+        std::exit(1);
+    }
+    ::close(fd);
+    std::free(buf);
+    std::printf("%ld records, %.1f MB\n", long(N), n / 1e6);
+}
+
+void
+evict(const char* path)
+{
+    int fd = ::open(path, O_RDONLY);
+    ::posix_fadvise(fd, 0, 0, POSIX_FADV_DONTNEED);
+    ::close(fd);
+}
+
+struct Number {
+    long operator()(std::int64_t i) const { return long(i); }
+
+    long operator()(double d) const { return long(d); }
+
+    long operator()(std::string_view s) const { return long(s.size()); }
+
+    long operator()(const std::string& s) const { return long(s.size()); }
+};
+
+long
+parse(const char* path)
+{
+    FILE* f = std::fopen(path, "rb");
+    std::fseek(f, 0, SEEK_END);
+    const size_t n = size_t(std::ftell(f));
+    std::fseek(f, 0, SEEK_SET);
+    auto* buf = static_cast<std::byte*>(
+                    std::aligned_alloc(64, (n + 63) / 64 * 64));
+    if (std::fread(buf, 1, n, f) != n) {
+        std::abort();
+    }
+    std::fclose(f);
+    auto records = std::deserialize<V>(std::span<const std::byte>(buf, n));
+    std::vector<V> out;
+    out.reserve(records.size());
+    for (auto r : records) {
+        out.push_back(std::visit([](auto x) -> V {
+            if constexpr (std::is_same_v<decltype(x), std::string_view>) {
+                return V(std::string(x));
+            } else {
+                return V(x);
+            }
+        }, r));
+    }
+    std::free(buf);
+    long r = std::visit(Number{}, out[out.size() / 2]);
+    resident_kb = rss_kb();
+    return r;
+}
+
+long
+open_first(const char* path)
+{
+    std::mapped_array<V> a(path);
+    long r = std::visit(Number{}, a[a.size() / 2]);
+    resident_kb = rss_kb();
+    return r;
+}
+
+long
+sample(const char* path)
+{
+    std::mapped_array<V> a(path, std::map_advice::random);
+    long sum = 0;
+    for (size_t i = 0; i < a.size(); i += 1000) {
+        sum += std::visit(Number{}, a[i]);
+    }
+    resident_kb = rss_kb();
+    return sum;
+}
+
+long
+scan(const char* path)
+{
+    std::mapped_array<V> a(path, std::map_advice::sequential);
+    long sum = 0;
+    for (auto r : a) {
+        sum += std::visit(Number{}, r);
+    }
+    resident_kb = rss_kb();
+    return sum;
+}
+
+void
+run(const char* name, long (*f)(const char*), const char* path, bool cold)
+{
+    if (cold) {
+        evict(path);
+    }
+    std::fflush(stdout);
+    if (pid_t pid = ::fork()) {
+        int status;
+        ::waitpid(pid, &status, 0);
+        return;
+    }
+    long before = rss_kb();
+    auto t0 = Clock::now();
+    long sum = f(path);
+    std::chrono::duration<double, std::milli> d = Clock::now() - t0;
+    std::printf("%-6s %-4s %9.2f ms  RSS +%7.1f MB  (%ld)\n", name,
+                cold ? "cold" : "warm", d.count(),
+                (resident_kb - before) / 1e3, sum);
+    std::fflush(stdout);
+    ::_exit(0);
+}
+
+int
+main(int argc, char** argv)
+{
+    const char* path = argc > 1 ? argv[1] : "/tmp/mapped_cold_start.bin";
+    write_file(path);
+    for (bool cold : { true, false }) {
+        run("parse", parse, path, cold);
+        run("open", open_first, path, cold);
+        run("sample", sample, path, cold);
+        run("scan", scan, path, cold);
+    }
+    ::unlink(path);
+}
@@ -0,0 +1,148 @@
+// once_optional::get_or_init against std::call_once, under contention.
+//
+// For each thread count given (default 1 2 4 8 16 32 64), two phases:
+//
+//  - init: the threads are released together onto a fresh object, and all
+//    call get_or_init with an initializer that spins for INIT_US
+//    microseconds. Prints the mean time, over ROUNDS objects, from the
+//    release until every thread has the value and has been joined: the
+//    initializer itself, parking and waking the losers, and thread exit.
+//  - get: every thread then calls get_or_init LOOKUPS times on the
+//    initialized object. Prints the time per call and thread.
+//
+// The call_once version is a std::once_flag next to an optional, and
+// returns *value after std::call_once.
+//
+//   g++ -std=c++20 -O2 -pthread -I.. once_init.cc && ./a.out
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "../once_optional.h"
+
+#ifndef INIT_US
+# define INIT_US 50
+#endif
+#ifndef ROUNDS
+# define ROUNDS 200
+#endif
+#ifndef LOOKUPS
+# define LOOKUPS 10000000
+#endif
+
+using Clock = std::chrono::steady_clock;
+
+struct Table {
+    long entries[16];
+};
+
+Table
+build(long seed)
+{
+    auto until = Clock::now() + std::chrono::microseconds(INIT_US);
+    while (Clock::now() < until) { }
+    Table t;
+    for (long& e : t.entries) {
+        e = seed;
+    }
+    return t;
+}
+
+struct Once_optional {
+    std::once_optional<Table> value;
+
+    const Table&
+    get(long seed)
+    {
+        return value.get_or_init([seed] { return build(seed); });
+    }
+};
+
+struct Call_once {
+    std::once_flag flag;
+    std::optional<Table> value;
+
+    const Table&
+    get(long seed)
+    {
+        std::call_once(flag, [&] { value.emplace(build(seed)); });
+        return *value;
+    }
+};
+
+template<typename _Lazy>
+void
+run(const char* name, int threads)
+{
+    double init_us = 0;
+    for (int r = 0; r < ROUNDS; ++r) {
+        _Lazy lazy;
+        std::atomic<int> ready{0};
+        std::atomic<bool> go{false};
+        std::vector<std::thread> workers;
+        for (int t = 0; t < threads; ++t) {
+            workers.emplace_back([&] {
+                ++ready;
+                while (!go.load(std::memory_order_acquire)) {
+                    std::this_thread::yield();
+                }
+                if (lazy.get(r).entries[0] != r) {
+                    std::abort();
+                }
+            });
+        }
+        while (ready != threads) {
+            std::this_thread::yield();
+        }
+        auto t0 = Clock::now();
+        go.store(true, std::memory_order_release);
+        for (auto& t : workers) {
+            t.join();
+        }
+        init_us += std::chrono::duration<double, std::micro>(
+                       Clock::now() - t0).count();
+    }
+
+    _Lazy lazy;
+    lazy.get(1);
+    std::vector<std::thread> workers;
+    auto t0 = Clock::now();
+    for (int t = 0; t < threads; ++t) {
+        workers.emplace_back([&] {
+            long sum = 0;
+            for (long i = 0; i < LOOKUPS; ++i) {
+                sum += lazy.get(i).entries[i % 16];
+            }
+            if (sum != LOOKUPS) {
+                std::abort();
+            }
+        });
+    }
+    for (auto& t : workers) {
+        t.join();
+    }
+    std::chrono::duration<double, std::nano> get = Clock::now() - t0;
+    std::printf("%-13s %2d threads: init %7.1f us  get %5.2f ns\n", name,
+                threads, init_us / ROUNDS,
+                get.count() / (double(LOOKUPS) * threads));
+}
+
+int
+main(int argc, char** argv)
+{
+    std::vector<int> counts;
+    for (int i = 1; i < argc; ++i) {
+        counts.push_back(std::atoi(argv[i]));
+    }
+    if (counts.empty()) {
+        counts = { 1, 2, 4, 8, 16, 32, 64 };
+    }
+    for (int n : counts) {
+        run<Once_optional>("once_optional", n);
+        run<Call_once>("call_once", n);
+    }
+}
@@ -0,0 +1,70 @@
+#!/bin/sh
+# Instantiations, compile time and object size of many optional types, with
+# the prototype optional/optional.h and with fixed_optional.h.
+#
+#   bench/optional_instantiations.sh [N [g++ options...]]      default N: 500
+#
+# Generates a TU that uses optional<_S<I>> for N distinct structs holding a
+# std::string: copy, move, assignment, observers, transform and value_or.
+# For each header, compiles it at -O0 and -O2 and prints both compile
+# times, the number of std:: functions naming optional that the -O0 object
+# defines (one per instantiated member of optional, its bases and its
+# helpers), and the size of .text at each level.
+
+cd "$(dirname "$0")" || exit 1
+CXX=${CXX:-g++}
+n=${1:-500}
+[ $# -gt 0 ] && shift
+dir=$(mktemp -d) || exit 1
+trap 'rm -rf "$dir"' EXIT
+
+awk -v n="$n" 'BEGIN {
+    print "#include <string>"
+    print "#include HEADER"
+    print "template<int _Np> struct _S { std::string _M_s; };"
+    print "template<int _Np>"
+    print "int use(std::optional<_S<_Np>> __a) {"
+    print "    std::optional<_S<_Np>> __b = __a, __c = std::move(__a);"
+    print "    __b = __c; __c = std::move(__b); __a = _S<_Np>{\"x\"};"
+    print "    auto __t = __c.transform([](const _S<_Np>& __s) { return __s._M_s; });"
+    print "    return int(__c->_M_s.size() + __a.value()._M_s.size()"
+    print "               + __t.value_or(\"\").size() + __b.has_value());"
+    print "}"
+    print "int total() {"
+    print "    return 0"
+    for (i = 0; i < n; i++) print "        + use<" i ">({})"
+    print "        ;"
+    print "}"
+}' > "$dir/tu.cc"
+
+# Compiles tu.cc with HEADER $1 at level $2, and prints the seconds taken.
+build() {
+    h=$1 opt=$2
+    shift 2
+    start=$(date +%s.%N)
+    $CXX -std=c++20 $opt "$@" -DHEADER="$h" -c -o "$dir/tu$opt.o" \
+        "$dir/tu.cc" || exit 1
+    end=$(date +%s.%N)
+    awk -v s="$start" -v e="$end" 'BEGIN { print e - s }'
+}
+
+text() {
+    size -A "$1" | awk '$1 ~ /^\.text/ { s += $2 } END { print s }'
+}
+
+printf '%-28s %12s %10s %7s %13s %7s\n' "$n types" "-O0 seconds" \
+    functions .text "-O2 seconds" .text
+proto="\"$PWD/../../optional/optional.h\""
+fixed="\"$PWD/../fixed_optional.h\""
+for h in "$proto" "$fixed"; do
+    o0=$(build "$h" -O0 "$@") || { echo "$h: build failed"; exit 1; }
+    o2=$(build "$h" -O2 "$@") || { echo "$h: build failed"; exit 1; }
+    fns=$(nm -C --defined-only "$dir/tu-O0.o" \
+          | awk '$2 ~ /^[TtWw]$/ { $1 = $2 = ""; sub(/^ +/, "") }
+                 /^std::/ && /[Oo]ptional/ { n++ } END { print n + 0 }')
+    awk -v h="$(basename "$h" | tr -d '"')" -v a="$o0" -v f="$fns" \
+        -v t0="$(text "$dir/tu-O0.o")" -v b="$o2" \
+        -v t2="$(text "$dir/tu-O2.o")" \
+        'BEGIN { printf "%-28s %12.2f %10d %7d %13.2f %7d\n",
+                 h, a, f, t0, b, t2 }'
+done
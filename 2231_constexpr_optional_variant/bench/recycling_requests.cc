@@ -0,0 +1,110 @@
+// Allocator calls and time per request of scratch optionals, with and
+// without recycling_optional.
+//
+// Each request fills three scratch values, a body buffer, a header string
+// and a token list, with sizes drawn from a fixed pseudo-random sequence,
+// and resets them at the end. With optional every request constructs them
+// afresh, so each allocates as it grows; with recycling_optional they keep
+// their capacity, and allocate only when a request is larger than any
+// before it. Allocations are counted by replacing the global operator new.
+//
+//   g++ -std=c++20 -O2 -I.. recycling_requests.cc && ./a.out
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+#include <string>
+#include <vector>
+#include "../recycling_optional.h"
+
+#ifndef REQUESTS
+# define REQUESTS 200000
+#endif
+
+static long allocations;
+
+void*
+operator new(std::size_t n)
+{
+    ++allocations;
+    if (void* p = std::malloc(n ? n : 1)) {
+        return p;
+    }
+    throw std::bad_alloc();
+}
+
+void operator delete(void* p) noexcept { std::free(p); }
+
+void operator delete(void* p, std::size_t) noexcept { std::free(p); }
+
+template<template<typename> class _Opt>
+struct Scratch {
+    _Opt<std::vector<char>> body;
+    _Opt<std::string> header;
+    _Opt<std::vector<int>> tokens;
+};
+
+// Sizes of a request: mostly small, occasionally large.
+struct Sizes {
+    unsigned state = 12345;
+
+    unsigned
+    next(unsigned small, unsigned large)
+    {
+        state = state * 1103515245 + 12345;
+        unsigned r = state >> 8;
+        return r % 64 == 0 ? r % large : r % small;
+    }
+};
+
+template<template<typename> class _Opt>
+long
+handle(Scratch<_Opt>& s, Sizes& sizes)
+{
+    s.body.emplace();
+    for (unsigned i = 0, n = sizes.next(512, 16384); i < n; ++i) {
+        s.body->push_back(char(i));
+    }
+    s.header.emplace();
+    for (unsigned i = 0, n = sizes.next(64, 1024); i < n; ++i) {
+        s.header->push_back('a' + i % 26);
+    }
+    s.tokens.emplace();
+    for (unsigned i = 0, n = sizes.next(32, 4096); i < n; ++i) {
+        s.tokens->push_back(int(i));
+    }
+    long r = long(s.body->size() + s.header->size() + s.tokens->size());
+    s.body.reset();
+    s.header.reset();
+    s.tokens.reset();
+    return r;
+}
+
+template<template<typename> class _Opt>
+long
+run(const char* name)
+{
+    Scratch<_Opt> s;
+    Sizes sizes;
+    long sum = 0;
+    allocations = 0;
+    auto start = std::chrono::steady_clock::now();
+    for (int r = 0; r < REQUESTS; ++r) {
+        sum += handle(s, sizes);
+    }
+    std::chrono::duration<double, std::nano> d
+        = std::chrono::steady_clock::now() - start;
+    std::printf("%-18s %8ld allocations, %7.4f/request, %7.1f ns/request\n",
+                name, allocations, double(allocations) / REQUESTS,
+                d.count() / REQUESTS);
+    return sum;
+}
+
+int
+main()
+{
+    long a = run<std::optional>("optional");
+    long b = run<std::recycling_optional>("recycling_optional");
+    return a != b;
+}
@@ -0,0 +1,161 @@
+// Read throughput of shared_variant against a variant behind a shared_mutex,
+// with a background writer.
+//
+// For each thread count given (default 1 2 4 8), that many readers visit
+// the value for MS milliseconds while one writer replaces it every
+// WRITE_US microseconds, alternating between the two 1 KiB alternatives.
+// Prints the total visits per second. Readers of shared_variant only load
+// the sequence counter; readers of the shared_mutex all write its cache
+// line, so only the former should scale with the number of cores.
+//
+//   g++ -std=c++20 -O2 -pthread -I.. shared_read.cc && ./a.out 1 2 4 8
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <mutex>
+#include <shared_mutex>
+#include <thread>
+#include <vector>
+#include "../shared_optional_variant.h"
+
+#ifndef MS
+# define MS 500
+#endif
+#ifndef WRITE_US
+# define WRITE_US 1000
+#endif
+
+struct Routes {
+    int next_hop[256];
+};
+
+struct Limits {
+    long quota[128];
+};
+
+using Config = std::variant<Routes, Limits>;
+
+Config
+make_config(int generation)
+{
+    if (generation % 2) {
+        Limits l;
+        for (long& q : l.quota) {
+            q = generation;
+        }
+        return l;
+    }
+    Routes r;
+    for (int& h : r.next_hop) {
+        h = generation;
+    }
+    return r;
+}
+
+// Every field of one alternative holds the same value, so a torn read
+// would show up as a mismatch.
+struct Lookup {
+    unsigned key;
+
+    long
+    operator()(const Routes& r) const
+    {
+        return r.next_hop[key % 256] == r.next_hop[(key + 128) % 256]
+               ? r.next_hop[key % 256] : -1;
+    }
+
+    long
+    operator()(const Limits& l) const
+    {
+        return l.quota[key % 128] == l.quota[(key + 64) % 128]
+               ? l.quota[key % 128] : -1;
+    }
+};
+
+struct Seqlock_config {
+    std::shared_variant<Routes, Limits> value{make_config(0)};
+
+    long read(unsigned key) const { return value.visit(Lookup{key}); }
+
+    void write(const Config& c) { value.store(c); }
+};
+
+struct Mutex_config {
+    mutable std::shared_mutex mutex;
+    Config value = make_config(0);
+
+    long
+    read(unsigned key) const
+    {
+        std::shared_lock lock(mutex);
+        return std::visit(Lookup{key}, value);
+    }
+
+    void
+    write(const Config& c)
+    {
+        std::unique_lock lock(mutex);
+        value = c;
+    }
+};
+
+template<typename _Config>
+void
+run(const char* name, int readers)
+{
+    _Config config;
+    std::atomic<bool> stop{false};
+    std::atomic<long> reads{0};
+    std::atomic<bool> torn{false};
+
+    std::thread writer([&] {
+        for (int g = 1; !stop.load(std::memory_order_relaxed); ++g) {
+            config.write(make_config(g));
+            std::this_thread::sleep_for(std::chrono::microseconds(WRITE_US));
+        }
+    });
+    std::vector<std::thread> threads;
+    for (int t = 0; t < readers; ++t) {
+        threads.emplace_back([&, t] {
+            long n = 0;
+            for (unsigned key = t; !stop.load(std::memory_order_relaxed);
+                 ++key) {
+                if (config.read(key) < 0) {
+                    torn = true;
+                }
+                ++n;
+            }
+            reads += n;
+        });
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(MS));
+    stop = true;
+    for (auto& t : threads) {
+        t.join();
+    }
+    writer.join();
+    if (torn) {
+        std::printf("%s: torn read\n", name);
+        std::exit(1);
+    }
+    std::printf("%-14s %2d readers: %8.1f M visits/s\n", name, readers,
+                reads / (MS * 1e3));
+}
+
+int
+main(int argc, char** argv)
+{
+    std::vector<int> counts;
+    for (int i = 1; i < argc; ++i) {
+        counts.push_back(std::atoi(argv[i]));
+    }
+    if (counts.empty()) {
+        counts = { 1, 2, 4, 8 };
+    }
+    for (int n : counts) {
+        run<Seqlock_config>("shared_variant", n);
+        run<Mutex_config>("shared_mutex", n);
+    }
+}
@@ -0,0 +1,60 @@
+// Start-up cost of a static table of variants whose alternative has a
+// non-trivial destructor.
+//
+// The table has 16384 entries, half of them Handler, and is declared
+// without constinit, so it compiles whether or not the headers can
+// initialize it as a constant. A constructor of priority 101, which runs
+// before the table's initializer, stamps the time; main prints how long
+// the dynamic initialization of this file took. bench/static_table.sh also
+// reports the size of that initialization code.
+//
+//   g++ -std=c++20 -O2 -I.. static_table.cc && ./a.out
+
+#include <chrono>
+#include <cstdio>
+#include "fixed_variant.h"
+
+struct Handler {
+    const char* name;
+    int (*fn)(int);
+
+    constexpr Handler(const char* n, int (*f)(int))
+        : name(n), fn(f)
+    { }
+
+    ~Handler() { }
+};
+
+int twice(int i) { return 2 * i; }
+
+using Entry = std::variant<int, Handler>;
+
+#define E1 Entry(std::in_place_type<Handler>, "twice", &twice), Entry(7),
+#define E4 E1 E1 E1 E1
+#define E16 E4 E4 E4 E4
+#define E256 E16 E16 E16 E16 E16 E16 E16 E16 \
+             E16 E16 E16 E16 E16 E16 E16 E16
+#define E4096 E256 E256 E256 E256 E256 E256 E256 E256 \
+              E256 E256 E256 E256 E256 E256 E256 E256
+
+static std::chrono::steady_clock::time_point start;
+
+__attribute__((constructor(101))) static void
+stamp()
+{
+    start = std::chrono::steady_clock::now();
+}
+
+const Entry table[] = { E4096 E4096 };
+
+int
+main(int argc, char**)
+{
+    std::chrono::duration<double, std::micro> d
+        = std::chrono::steady_clock::now() - start;
+    const Entry& e = table[argc * 1001 % std::size(table)];
+    int r = e.index() ? std::get<1>(e).fn(argc) : std::get<0>(e);
+    std::printf("%zu entries: %.1f us of dynamic initialization\n",
+                std::size(table), d.count());
+    return r == 0;
+}
@@ -0,0 +1,31 @@
+#!/bin/sh
+# Start-up cost of static_table.cc, built against each header directory
+# given (default: the headers in this tree).
+#
+#   bench/static_table.sh [include-dir...]
+#
+# For each, prints the compile time, the bytes of dynamic initialization
+# code in the executable and the fastest of ten measured initializations.
+
+cd "$(dirname "$0")" || exit 1
+CXX=${CXX:-g++}
+out=$(mktemp) || exit 1
+trap 'rm -f "$out"' EXIT
+
+[ $# -gt 0 ] || set -- ..
+for dir in "$@"; do
+    start=$(date +%s.%N)
+    $CXX -std=c++20 -O2 -w -I"$dir" -o "$out" static_table.cc \
+        || { echo "$dir: build failed"; exit 1; }
+    end=$(date +%s.%N)
+    init=$(nm -S -C -t d "$out" | awk '
+        / _GLOBAL__sub_I_| __static_initialization_and_destruction/ {
+            n += $2
+        }
+        END { print n + 0 }')
+    us=$(for i in 1 2 3 4 5 6 7 8 9 10; do "$out"; done \
+         | awk '{ print $3 }' | sort -n | head -1)
+    awk -v d="$dir" -v s="$start" -v e="$end" -v b="$init" -v u="$us" \
+        'BEGIN { printf "%-40s build %6.2f s  init code %7d bytes  %7.1f us\n",
+                 d, e - s, b, u }'
+done
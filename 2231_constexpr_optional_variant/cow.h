@@ -0,0 +1,266 @@
+#ifndef _GLIBCXX_COW
+#define _GLIBCXX_COW 1
+
+#if __cplusplus > 201703L
+
+#include <atomic>
+#include <compare>
+#include <new>
+#include "fixed_variant.h"
+
+namespace std _GLIBCXX_VISIBILITY(default)
+{
+_GLIBCXX_BEGIN_NAMESPACE_VERSION
+
+/**
+  * @brief Shares a _Tp between copies and clones it on the first write.
+  *
+  * Meant as a variant alternative for types that are large and mostly
+  * read: copying variant<_Small, cow<_Large>> bumps a reference count
+  * instead of copying _Large. Reading never clones. std::visit sees the
+  * alternative as const _Tp&, even through a non-const variant, so a
+  * visitor cannot write to a shared value by accident. Writing goes through
+  * write(), which clones the value first if another cow shares it.
+  *
+  * As with shared_ptr, distinct cow objects that share a value can be used
+  * from different threads at the same time, including calls to write(). A
+  * single cow object is no more thread safe than a _Tp.
+  *
+  * Moves steal the pointer and leave the source valueless. A valueless cow
+  * compares equal to another valueless one and less than any other. It
+  * must not be dereferenced, nor visited inside a variant: std::visit has
+  * no _Tp to pass for it.
+  */
+template<typename _Tp>
+class cow
+{
+    static_assert(is_object_v<_Tp> && !is_array_v<_Tp> && !is_const_v<_Tp>);
+    static_assert(!is_same_v<_Tp, in_place_t>);
+
+    struct _Node {
+        atomic<size_t> _M_refs;
+        _Tp _M_value;
+
+        template<typename... _Args>
+        explicit
+        _Node(_Args&&... __args)
+            : _M_refs(1), _M_value(std::forward<_Args>(__args)...)
+        { }
+    };
+
+    _Node* _M_ptr;
+
+    template<typename... _Args>
+    static _Node*
+    _S_make(_Args&&... __args)
+    {
+        return new _Node(std::forward<_Args>(__args)...);
+    }
+
+    // The decrement releases our reads of the value to the owner that
+    // deletes it or, in write(), writes to it.
+    static void
+    _S_release(_Node* __p) noexcept
+    {
+        if (__p && (__p->_M_refs.load(memory_order_acquire) == 1
+                    || __p->_M_refs.fetch_sub(1, memory_order_acq_rel) == 1)) {
+            delete __p;
+        }
+    }
+
+    explicit
+    cow(_Node* __p) noexcept
+        : _M_ptr(__p)
+    { }
+
+public:
+    using value_type = _Tp;
+
+    cow()
+    requires is_default_constructible_v<_Tp>
+        : _M_ptr(_S_make())
+    { }
+
+    template<typename _Up = _Tp>
+    requires (!is_same_v<__remove_cvref_t<_Up>, cow>
+              && !is_same_v<__remove_cvref_t<_Up>, in_place_t>
+              && is_constructible_v<_Tp, _Up>)
+    cow(_Up&& __u)
+        : _M_ptr(_S_make(std::forward<_Up>(__u)))
+    { }
+
+    template<typename... _Args>
+    requires is_constructible_v<_Tp, _Args...>
+    explicit
+    cow(in_place_t, _Args&&... __args)
+        : _M_ptr(_S_make(std::forward<_Args>(__args)...))
+    { }
+
+    cow(const cow& __other) noexcept
+        : _M_ptr(__other._M_ptr)
+    {
+        if (_M_ptr) {
+            _M_ptr->_M_refs.fetch_add(1, memory_order_relaxed);
+        }
+    }
+
+    cow(cow&& __other) noexcept
+        : _M_ptr(std::__exchange(__other._M_ptr, nullptr))
+    { }
+
+    ~cow()
+    {
+        _S_release(_M_ptr);
+    }
+
+    cow&
+    operator=(const cow& __other) noexcept
+    {
+        cow(__other).swap(*this);
+        return *this;
+    }
+
+    cow&
+    operator=(cow&& __other) noexcept
+    {
+        cow(std::move(__other)).swap(*this);
+        return *this;
+    }
+
+    // Assigns in place when the value is not shared.
+    template<typename _Up = _Tp>
+    requires (!is_same_v<__remove_cvref_t<_Up>, cow>
+              && is_constructible_v<_Tp, _Up>
+              && is_assignable_v<_Tp&, _Up>)
+    cow&
+    operator=(_Up&& __u)
+    {
+        if (unique()) {
+            _M_ptr->_M_value = std::forward<_Up>(__u);
+        } else {
+            cow(_S_make(std::forward<_Up>(__u))).swap(*this);
+        }
+        return *this;
+    }
+
+    void
+    swap(cow& __other) noexcept
+    {
+        std::swap(_M_ptr, __other._M_ptr);
+    }
+
+    friend void
+    swap(cow& __lhs, cow& __rhs) noexcept
+    {
+        __lhs.swap(__rhs);
+    }
+
+    // Observers.
+    bool
+    valueless_after_move() const noexcept
+    {
+        return _M_ptr == nullptr;
+    }
+
+    // The number of cow objects sharing the value, 0 if valueless. Only a
+    // hint when other threads hold copies.
+    size_t
+    use_count() const noexcept
+    {
+        return _M_ptr ? _M_ptr->_M_refs.load(memory_order_relaxed) : 0;
+    }
+
+    // True if write() will not clone.
+    bool
+    unique() const noexcept
+    {
+        return _M_ptr && _M_ptr->_M_refs.load(memory_order_acquire) == 1;
+    }
+
+    const _Tp*
+    operator->() const noexcept
+    {
+        __glibcxx_assert(_M_ptr);
+        return std::__addressof(_M_ptr->_M_value);
+    }
+
+    const _Tp&
+    operator*() const noexcept
+    {
+        __glibcxx_assert(_M_ptr);
+        return _M_ptr->_M_value;
+    }
+
+    // Mutable access, cloning the value first if it is shared. The
+    // reference is invalidated by copying *this and then writing to the
+    // copy or to *this through the reference.
+    _Tp&
+    write()
+    {
+        __glibcxx_assert(_M_ptr);
+        if (!unique()) {
+            cow(_S_make(as_const(_M_ptr->_M_value))).swap(*this);
+        }
+        return _M_ptr->_M_value;
+    }
+};
+
+// A valueless cow only equals another, and orders before any value.
+template<typename _Tp>
+inline bool
+operator==(const cow<_Tp>& __lhs, const cow<_Tp>& __rhs)
+{
+    if (__lhs.valueless_after_move() || __rhs.valueless_after_move()) {
+        return __lhs.valueless_after_move() == __rhs.valueless_after_move();
+    }
+    return *__lhs == *__rhs;
+}
+
+template<typename _Tp>
+inline bool
+operator<(const cow<_Tp>& __lhs, const cow<_Tp>& __rhs)
+{
+    if (__lhs.valueless_after_move() || __rhs.valueless_after_move()) {
+        return !__rhs.valueless_after_move();
+    }
+    return *__lhs < *__rhs;
+}
+
+template<typename _Tp>
+requires three_way_comparable<_Tp>
+inline compare_three_way_result_t<_Tp>
+operator<=>(const cow<_Tp>& __lhs, const cow<_Tp>& __rhs)
+{
+    if (__lhs.valueless_after_move() || __rhs.valueless_after_move()) {
+        return !__lhs.valueless_after_move() <=> !__rhs.valueless_after_move();
+    }
+    return *__lhs <=> *__rhs;
+}
+
+// Hash.
+
+template<typename _Tp, bool = __poison_hash<_Tp>::__enable_hash_call>
+struct __cow_hash_call_base {
+    size_t
+    operator()(const cow<_Tp>& __t) const
+    noexcept(noexcept(hash<_Tp>{}(*__t)))
+    {
+        return __t.valueless_after_move() ? size_t(-1) : hash<_Tp>{}(*__t);
+    }
+};
+
+template<typename _Tp>
+struct __cow_hash_call_base<_Tp, false> {};
+
+template<typename _Tp>
+struct hash<cow<_Tp>>
+: private __poison_hash<_Tp>,
+public __cow_hash_call_base<_Tp> {
+};
+
+_GLIBCXX_END_NAMESPACE_VERSION
+} // namespace std
+
+#endif // C++20
+
+#endif // _GLIBCXX_COW
@@ -0,0 +1,11 @@
+// Definitions of the optional and variant specializations declared by
+// fixed_instantiations.h when _GLIBCXX_FIXED_EXTERN_TEMPLATE is 1. Compile
+// this file once, with the same options as the rest of the program, and
+// link it into the program or one of its libraries.
+//
+// To add specializations, declare them with the macros from
+// fixed_instantiations.h in a header and define them in a file like this.
+
+#include "fixed_instantiations.h"
+
+_GLIBCXX_FIXED_INSTANTIATIONS_LIST()
@@ -0,0 +1,102 @@
+#ifndef _GLIBCXX_FIXED_INSTANTIATIONS
+#define _GLIBCXX_FIXED_INSTANTIATIONS 1
+
+#if __cplusplus > 201703L
+
+#include <cstdint>
+#include <string>
+#include "fixed_optional.h"
+#include "fixed_variant.h"
+
+// Explicit instantiation of commonly used optional and variant
+// specializations, so that their special members, the visitation tables
+// those members use and their comparisons are compiled in one translation
+// unit instead of in every one that uses them.
+//
+// Each macro below takes `extern` as its first argument to declare the
+// instantiations, or nothing to define them:
+//
+//   // my_types.h
+//   _GLIBCXX_VARIANT_TEMPLATES(extern, int, my_type)
+//
+//   // my_types.cc, linked into the program once
+//   _GLIBCXX_VARIANT_TEMPLATES(, int, my_type)
+//
+// The comparison macros are separate because instantiating a comparison
+// requires the contained types to be comparable.
+//
+// Defining _GLIBCXX_FIXED_EXTERN_TEMPLATE to 1 before including this header
+// declares the specializations listed at the end of it, which are defined
+// by fixed_instantiations.cc.
+//
+// All of these members are constexpr and therefore inline. With
+// optimization the compiler instantiates them anyway in order to inline
+// them, so the declarations only pay off in unoptimized builds, where they
+// stop every translation unit from emitting its own out-of-line copies.
+
+// optional<_Tp>, and swap for it.
+#define _GLIBCXX_OPTIONAL_TEMPLATES(_Extern, _Tp) \
+  _Extern template class std::optional<_Tp>; \
+  _Extern template void std::swap(std::optional<_Tp>&, std::optional<_Tp>&);
+
+// The relational operators between two optional<_Tp>.
+#define _GLIBCXX_OPTIONAL_COMPARISON_TEMPLATES(_Extern, _Tp) \
+  _Extern template bool std::operator==(const std::optional<_Tp>&, \
+                                        const std::optional<_Tp>&); \
+  _Extern template bool std::operator!=(const std::optional<_Tp>&, \
+                                        const std::optional<_Tp>&); \
+  _Extern template bool std::operator<(const std::optional<_Tp>&, \
+                                       const std::optional<_Tp>&); \
+  _Extern template bool std::operator>(const std::optional<_Tp>&, \
+                                       const std::optional<_Tp>&); \
+  _Extern template bool std::operator<=(const std::optional<_Tp>&, \
+                                        const std::optional<_Tp>&); \
+  _Extern template bool std::operator>=(const std::optional<_Tp>&, \
+                                        const std::optional<_Tp>&);
+
+// variant<_Types...>, and swap for it.
+#define _GLIBCXX_VARIANT_TEMPLATES(_Extern, ...) \
+  _Extern template class std::variant<__VA_ARGS__>; \
+  _Extern template void std::swap(std::variant<__VA_ARGS__>&, \
+                                  std::variant<__VA_ARGS__>&);
+
+// The relational operators between two variant<_Types...>.
+#define _GLIBCXX_VARIANT_COMPARISON_TEMPLATES(_Extern, ...) \
+  _Extern template bool std::operator==(const std::variant<__VA_ARGS__>&, \
+                                        const std::variant<__VA_ARGS__>&); \
+  _Extern template bool std::operator!=(const std::variant<__VA_ARGS__>&, \
+                                        const std::variant<__VA_ARGS__>&); \
+  _Extern template bool std::operator<(const std::variant<__VA_ARGS__>&, \
+                                       const std::variant<__VA_ARGS__>&); \
+  _Extern template bool std::operator>(const std::variant<__VA_ARGS__>&, \
+                                       const std::variant<__VA_ARGS__>&); \
+  _Extern template bool std::operator<=(const std::variant<__VA_ARGS__>&, \
+                                        const std::variant<__VA_ARGS__>&); \
+  _Extern template bool std::operator>=(const std::variant<__VA_ARGS__>&, \
+                                        const std::variant<__VA_ARGS__>&);
+
+// The specializations instantiated by fixed_instantiations.cc.
+#define _GLIBCXX_FIXED_INSTANTIATIONS_LIST(_Extern) \
+  _GLIBCXX_OPTIONAL_TEMPLATES(_Extern, int) \
+  _GLIBCXX_OPTIONAL_COMPARISON_TEMPLATES(_Extern, int) \
+  _GLIBCXX_OPTIONAL_TEMPLATES(_Extern, std::int64_t) \
+  _GLIBCXX_OPTIONAL_COMPARISON_TEMPLATES(_Extern, std::int64_t) \
+  _GLIBCXX_OPTIONAL_TEMPLATES(_Extern, double) \
+  _GLIBCXX_OPTIONAL_COMPARISON_TEMPLATES(_Extern, double) \
+  _GLIBCXX_OPTIONAL_TEMPLATES(_Extern, std::string) \
+  _GLIBCXX_OPTIONAL_COMPARISON_TEMPLATES(_Extern, std::string) \
+  _GLIBCXX_VARIANT_TEMPLATES(_Extern, std::int64_t, double, std::string) \
+  _GLIBCXX_VARIANT_COMPARISON_TEMPLATES(_Extern, std::int64_t, double, \
+                                        std::string) \
+  _GLIBCXX_VARIANT_TEMPLATES(_Extern, std::monostate, std::int64_t, double, \
+                             std::string) \
+  _GLIBCXX_VARIANT_COMPARISON_TEMPLATES(_Extern, std::monostate, \
+                                        std::int64_t, double, std::string)
+
+#if _GLIBCXX_FIXED_EXTERN_TEMPLATE
+_GLIBCXX_FIXED_INSTANTIATIONS_LIST(extern)
+#endif
+
+#endif // C++20
+
+#endif // _GLIBCXX_FIXED_INSTANTIATIONS
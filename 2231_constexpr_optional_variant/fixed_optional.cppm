@@ -0,0 +1,12 @@
+// Module interface unit for optional. It re-exports the header unit of
+// fixed_optional.h, so an importer sees exactly what the header declares.
+// With GCC, build the header unit before the module:
+//
+//   g++ -std=c++20 -fmodules-ts -x c++-header fixed_optional.h
+//   g++ -std=c++20 -fmodules-ts -x c++ -c fixed_optional.cppm
+//
+// and then write `import fixed_optional;` in place of the #include.
+
+export module fixed_optional;
+
+export import "fixed_optional.h";
@@ -0,0 +1,855 @@
+#ifndef _GLIBCXX_OPTIONAL_CORE
+#define _GLIBCXX_OPTIONAL_CORE 1
+
+#if __cplusplus >= 201703L
+
+#include <utility>
+#include <type_traits>
+#include <exception>
+#include <new>
+#include <initializer_list>
+#include <bits/exception_defines.h>
+#include <bits/stl_construct.h>
+#include <bits/invoke.h>
+#include "fixed_optional_fwd.h"
+
+namespace std _GLIBCXX_VISIBILITY(default)
+{
+_GLIBCXX_BEGIN_NAMESPACE_VERSION
+
+/**
+ *  @addtogroup utilities
+ *  @{
+ */
+
+#define __cpp_lib_optional 201606L
+
+/**
+ *  @brief Exception class thrown when a disengaged optional object is
+ *  dereferenced.
+ *  @ingroup exceptions
+ */
+class bad_optional_access : public exception
+{
+public:
+    bad_optional_access() { }
+
+    virtual const char* what() const noexcept override
+    {
+        return "bad optional access";
+    }
+
+    virtual ~bad_optional_access() noexcept = default;
+};
+
+void
+__throw_bad_optional_access()
+__attribute__((__noreturn__));
+
+// XXX Does not belong here.
+inline void
+__throw_bad_optional_access() {
+    _GLIBCXX_THROW_OR_ABORT(bad_optional_access());
+}
+
+// Wraps the callable used by the monadic operations so that the contained
+// value can be initialized directly from the result of invoking it.
+template<typename _Fn>
+struct _Optional_func {
+    _Fn& _M_f;
+};
+
+// The contained value of an optional, or of once_optional and
+// recycling_optional, which manage the engaged state themselves.
+template<typename _Up, bool = is_trivially_destructible_v<_Up>>
+union _Optional_storage {
+    constexpr _Optional_storage() noexcept : _M_empty() { }
+
+    template<typename... _Args>
+    constexpr
+    _Optional_storage(in_place_t, _Args&&... __args)
+        : _M_value(std::forward<_Args>(__args)...)
+    { }
+
+    template<typename _Vp, typename... _Args>
+    constexpr
+    _Optional_storage(std::initializer_list<_Vp> __il, _Args&&... __args)
+        : _M_value(__il, std::forward<_Args>(__args)...)
+    { }
+
+    template<typename _Fn, typename... _Args>
+    constexpr
+    _Optional_storage(_Optional_func<_Fn> __f, _Args&&... __args)
+        : _M_value(std::__invoke(std::forward<_Fn>(__f._M_f),
+                                 std::forward<_Args>(__args)...))
+    { }
+
+    struct _Empty_byte { } _M_empty;
+    _Up _M_value;
+};
+
+template<typename _Up>
+union _Optional_storage<_Up, false> {
+    constexpr _Optional_storage() noexcept : _M_empty() { }
+
+    template<typename... _Args>
+    constexpr
+    _Optional_storage(in_place_t, _Args&&... __args)
+        : _M_value(std::forward<_Args>(__args)...)
+    { }
+
+    template<typename _Vp, typename... _Args>
+    constexpr
+    _Optional_storage(std::initializer_list<_Vp> __il, _Args&&... __args)
+        : _M_value(__il, std::forward<_Args>(__args)...)
+    { }
+
+    template<typename _Fn, typename... _Args>
+    constexpr
+    _Optional_storage(_Optional_func<_Fn> __f, _Args&&... __args)
+        : _M_value(std::__invoke(std::forward<_Fn>(__f._M_f),
+                                 std::forward<_Args>(__args)...))
+    { }
+
+    // User-provided destructor is needed when _Up has non-trivial dtor.
+    constexpr ~_Optional_storage() { }
+
+    struct _Empty_byte { } _M_empty;
+    _Up _M_value;
+};
+
+/**
+  * @brief Storage, engaged flag and special members of optional.
+  *
+  * A single class, so that copying an optional in an unoptimized build is
+  * one call from optional into _Optional_base and from there to _Tp,
+  * instead of a walk through payload and base layers. Each special member
+  * is declared twice: defaulted, constrained on _Tp making it trivial, and
+  * user-provided, constrained on _Tp allowing it but not trivially. When
+  * neither is eligible the member is absent, and with it the corresponding
+  * member of optional.
+  *
+  * @see optional
+  */
+template <typename _Tp>
+struct _Optional_base {
+    using _Stored_type = remove_const_t<_Tp>;
+
+    static constexpr bool _S_copy_ctor = is_copy_constructible_v<_Tp>;
+    static constexpr bool _S_move_ctor = is_move_constructible_v<_Tp>;
+    static constexpr bool _S_copy_assign =
+        _S_copy_ctor && is_copy_assignable_v<_Tp>;
+    static constexpr bool _S_move_assign =
+        _S_move_ctor && is_move_assignable_v<_Tp>;
+
+    static constexpr bool _S_trivial_dtor = is_trivially_destructible_v<_Tp>;
+    static constexpr bool _S_trivial_copy_ctor =
+        is_trivially_copy_constructible_v<_Tp>;
+    static constexpr bool _S_trivial_move_ctor =
+        is_trivially_move_constructible_v<_Tp>;
+    static constexpr bool _S_trivial_copy_assign =
+        _S_trivial_dtor && _S_trivial_copy_ctor
+        && is_trivially_copy_assignable_v<_Tp>;
+    static constexpr bool _S_trivial_move_assign =
+        _S_trivial_dtor && _S_trivial_move_ctor
+        && is_trivially_move_assignable_v<_Tp>;
+
+    // Constructors for disengaged optionals.
+    constexpr _Optional_base() = default;
+
+    // Constructors for engaged optionals.
+    template<typename... _Args,
+             enable_if_t<is_constructible_v<_Tp, _Args&&...>, bool> = false>
+    constexpr explicit _Optional_base(in_place_t __tag, _Args&&... __args)
+        : _M_payload(__tag, std::forward<_Args>(__args)...),
+          _M_engaged(true)
+    { }
+
+    template<typename _Up, typename... _Args,
+             enable_if_t<is_constructible_v<_Tp,
+                                            initializer_list<_Up>&,
+                                            _Args&&...>, bool> = false>
+    constexpr explicit _Optional_base(in_place_t,
+                                      initializer_list<_Up> __il,
+                                      _Args&&... __args)
+        : _M_payload(__il, std::forward<_Args>(__args)...),
+          _M_engaged(true)
+    { }
+
+    // Copy and move constructors.
+    _Optional_base(const _Optional_base&)
+    requires _S_trivial_copy_ctor = default;
+
+    constexpr _Optional_base(const _Optional_base& __other)
+    requires (_S_copy_ctor && !_S_trivial_copy_ctor)
+    {
+        if (__other._M_engaged) {
+            this->_M_construct(__other._M_get());
+        }
+    }
+
+    _Optional_base(_Optional_base&&)
+    requires _S_trivial_move_ctor = default;
+
+    constexpr _Optional_base(_Optional_base&& __other)
+    noexcept(is_nothrow_move_constructible_v<_Tp>)
+    requires (_S_move_ctor && !_S_trivial_move_ctor)
+    {
+        if (__other._M_engaged) {
+            this->_M_construct(std::move(__other._M_get()));
+        }
+    }
+
+    // Assignment operators.
+    _Optional_base& operator=(const _Optional_base&)
+    requires _S_trivial_copy_assign = default;
+
+    constexpr _Optional_base&
+    operator=(const _Optional_base& __other)
+    requires (_S_copy_assign && !_S_trivial_copy_assign)
+    {
+        if (this->_M_engaged && __other._M_engaged) {
+            this->_M_get() = __other._M_get();
+        } else {
+            if (__other._M_engaged) {
+                this->_M_construct(__other._M_get());
+            } else {
+                this->_M_reset();
+            }
+        }
+        return *this;
+    }
+
+    _Optional_base& operator=(_Optional_base&&)
+    requires _S_trivial_move_assign = default;
+
+    constexpr _Optional_base&
+    operator=(_Optional_base&& __other)
+    noexcept(__and_v<is_nothrow_move_constructible<_Tp>,
+             is_nothrow_move_assignable<_Tp>>)
+    requires (_S_move_assign && !_S_trivial_move_assign)
+    {
+        if (this->_M_engaged && __other._M_engaged) {
+            this->_M_get() = std::move(__other._M_get());
+        } else {
+            if (__other._M_engaged) {
+                this->_M_construct(std::move(__other._M_get()));
+            } else {
+                this->_M_reset();
+            }
+        }
+        return *this;
+    }
+
+    ~_Optional_base() requires _S_trivial_dtor = default;
+
+    // Destructor needs to destroy the contained value:
+    constexpr ~_Optional_base()
+    {
+        this->_M_reset();
+    }
+
+    _Optional_storage<_Stored_type> _M_payload;
+
+    bool _M_engaged = false;
+
+    // The _M_construct operation has !_M_engaged as a precondition
+    // while _M_destruct has _M_engaged as a precondition.
+    template<typename... _Args>
+    constexpr void
+    _M_construct(_Args&&... __args)
+    noexcept(is_nothrow_constructible_v<_Stored_type, _Args...>)
+    {
+        std::construct_at(std::__addressof(this->_M_payload._M_value),
+            std::forward<_Args>(__args)...);
+        this->_M_engaged = true;
+    }
+
+    // Initializes the contained value from the result of invoking __f,
+    // so that a prvalue result is constructed in place without a move.
+    template<typename _Fn, typename... _Args>
+    constexpr void
+    _M_apply(_Optional_func<_Fn> __f, _Args&&... __args)
+    {
+        std::construct_at(std::__addressof(this->_M_payload), __f,
+                          std::forward<_Args>(__args)...);
+        this->_M_engaged = true;
+    }
+
+    constexpr void
+    _M_destruct() noexcept
+    {
+        _M_engaged = false;
+        _M_payload._M_value.~_Stored_type();
+    }
+
+    // _M_reset is a 'safe' operation with no precondition.
+    constexpr void
+    _M_reset() noexcept
+    {
+        if (this->_M_engaged) {
+            _M_destruct();
+        }
+    }
+
+    constexpr bool _M_is_engaged() const noexcept
+    {
+        return this->_M_engaged;
+    }
+
+    // The _M_get operations have _M_engaged as a precondition.
+    // They exist to access the contained value with the appropriate
+    // const-qualification, because _M_payload has had the const removed.
+    constexpr _Tp&
+    _M_get() noexcept
+    {
+        __glibcxx_assert(this->_M_is_engaged());
+        return this->_M_payload._M_value;
+    }
+
+    constexpr const _Tp&
+    _M_get() const noexcept
+    {
+        __glibcxx_assert(this->_M_is_engaged());
+        return this->_M_payload._M_value;
+    }
+};
+
+template<typename _Tp>
+class optional;
+
+template<typename _Tp, typename _Up>
+using __converts_from_optional =
+    __or_<is_constructible<_Tp, const optional<_Up>&>,
+    is_constructible<_Tp, optional<_Up>&>,
+    is_constructible<_Tp, const optional<_Up>&&>,
+    is_constructible<_Tp, optional<_Up>&&>,
+    is_convertible<const optional<_Up>&, _Tp>,
+    is_convertible<optional<_Up>&, _Tp>,
+    is_convertible<const optional<_Up>&&, _Tp>,
+    is_convertible<optional<_Up>&&, _Tp>>;
+
+template<typename _Tp, typename _Up>
+using __assigns_from_optional =
+    __or_<is_assignable<_Tp&, const optional<_Up>&>,
+    is_assignable<_Tp&, optional<_Up>&>,
+    is_assignable<_Tp&, const optional<_Up>&&>,
+    is_assignable<_Tp&, optional<_Up>&&>>;
+
+template<typename _Tp>
+inline constexpr bool __is_optional_v = false;
+
+template<typename _Tp>
+inline constexpr bool __is_optional_v<optional<_Tp>> = true;
+
+template<typename _Res>
+struct _Optional_collect_sink;
+
+/**
+  * @brief Class template for optional values.
+  */
+template<typename _Tp>
+class optional
+    : private _Optional_base<_Tp>
+{
+    static_assert(!is_same_v<remove_cv_t<_Tp>, nullopt_t>);
+    static_assert(!is_same_v<remove_cv_t<_Tp>, in_place_t>);
+    static_assert(!is_reference_v<_Tp>);
+
+private:
+    using _Base = _Optional_base<_Tp>;
+
+    // SFINAE helpers
+    template<typename _Up>
+    using __not_self = __not_<is_same<optional, __remove_cvref_t<_Up>>>;
+    template<typename _Up>
+    using __not_tag = __not_<is_same<in_place_t, __remove_cvref_t<_Up>>>;
+    template<typename... _Cond>
+    using _Requires = enable_if_t<__and_v<_Cond...>, bool>;
+
+public:
+    using value_type = _Tp;
+
+    constexpr optional() = default;
+
+    constexpr optional(nullopt_t) noexcept { }
+
+    // Converting constructors for engaged optionals.
+    template<typename _Up = _Tp,
+             _Requires<__not_self<_Up>, __not_tag<_Up>,
+                       is_constructible<_Tp, _Up&&>,
+                       is_convertible<_Up&&, _Tp>> = true>
+    constexpr
+    optional(_Up&& __t)
+        : _Base(std::in_place, std::forward<_Up>(__t)) { }
+
+    template<typename _Up = _Tp,
+             _Requires<__not_self<_Up>, __not_tag<_Up>,
+                       is_constructible<_Tp, _Up&&>,
+                       __not_<is_convertible<_Up&&, _Tp>>> = false>
+                       explicit constexpr
+                       optional(_Up&& __t)
+                           : _Base(std::in_place, std::forward<_Up>(__t)) { }
+
+    template<typename _Up,
+             _Requires<__not_<is_same<_Tp, _Up>>,
+                       is_constructible<_Tp, const _Up&>,
+                       is_convertible<const _Up&, _Tp>,
+                       __not_<__converts_from_optional<_Tp, _Up>>> = true>
+                       constexpr
+                       optional(const optional<_Up>& __t)
+    {
+        if (__t) {
+            emplace(*__t);
+        }
+    }
+
+    template<typename _Up,
+             _Requires<__not_<is_same<_Tp, _Up>>,
+                       is_constructible<_Tp, const _Up&>,
+                       __not_<is_convertible<const _Up&, _Tp>>,
+                       __not_<__converts_from_optional<_Tp, _Up>>> = false>
+                       explicit constexpr
+                       optional(const optional<_Up>& __t)
+    {
+        if (__t) {
+            emplace(*__t);
+        }
+    }
+
+    template <typename _Up,
+              _Requires<__not_<is_same<_Tp, _Up>>,
+                        is_constructible<_Tp, _Up&&>,
+                        is_convertible<_Up&&, _Tp>,
+                        __not_<__converts_from_optional<_Tp, _Up>>> = true>
+                        constexpr
+                        optional(optional<_Up>&& __t)
+    {
+        if (__t) {
+            emplace(std::move(*__t));
+        }
+    }
+
+    template <typename _Up,
+              _Requires<__not_<is_same<_Tp, _Up>>,
+                        is_constructible<_Tp, _Up&&>,
+                        __not_<is_convertible<_Up&&, _Tp>>,
+                        __not_<__converts_from_optional<_Tp, _Up>>> = false>
+                        explicit constexpr
+                        optional(optional<_Up>&& __t)
+    {
+        if (__t) {
+            emplace(std::move(*__t));
+        }
+    }
+
+    template<typename... _Args,
+             _Requires<is_constructible<_Tp, _Args&&...>> = false>
+    explicit constexpr
+    optional(in_place_t, _Args&&... __args)
+        : _Base(std::in_place, std::forward<_Args>(__args)...) { }
+
+    template<typename _Up, typename... _Args,
+             _Requires<is_constructible<_Tp,
+                                        initializer_list<_Up>&,
+                                        _Args&&...>> = false>
+    explicit constexpr
+    optional(in_place_t, initializer_list<_Up> __il, _Args&&... __args)
+        : _Base(std::in_place, __il, std::forward<_Args>(__args)...) { }
+
+    // Assignment operators.
+    constexpr optional&
+    operator=(nullopt_t) noexcept
+    {
+        this->_M_reset();
+        return *this;
+    }
+
+    template<typename _Up = _Tp>
+    constexpr
+    enable_if_t<__and_v<__not_self<_Up>,
+                        __not_<__and_<is_scalar<_Tp>,
+                                      is_same<_Tp, decay_t<_Up>>>>,
+                                      is_constructible<_Tp, _Up>,
+                                      is_assignable<_Tp&, _Up>>,
+                               optional&>
+                        operator=(_Up&& __u)
+    {
+        if (this->_M_is_engaged()) {
+            this->_M_get() = std::forward<_Up>(__u);
+        } else {
+            this->_M_construct(std::forward<_Up>(__u));
+        }
+
+        return *this;
+    }
+
+    template<typename _Up>
+    constexpr
+    enable_if_t<__and_v<__not_<is_same<_Tp, _Up>>,
+                        is_constructible<_Tp, const _Up&>,
+                        is_assignable<_Tp&, _Up>,
+                        __not_<__converts_from_optional<_Tp, _Up>>,
+                        __not_<__assigns_from_optional<_Tp, _Up>>>,
+                               optional&>
+                        operator=(const optional<_Up>& __u)
+    {
+        if (__u) {
+            if (this->_M_is_engaged()) {
+                this->_M_get() = *__u;
+            } else {
+                this->_M_construct(*__u);
+            }
+        } else {
+            this->_M_reset();
+        }
+        return *this;
+    }
+
+    template<typename _Up>
+    constexpr
+    enable_if_t<__and_v<__not_<is_same<_Tp, _Up>>,
+                        is_constructible<_Tp, _Up>,
+                        is_assignable<_Tp&, _Up>,
+                        __not_<__converts_from_optional<_Tp, _Up>>,
+                        __not_<__assigns_from_optional<_Tp, _Up>>>,
+                               optional&>
+                        operator=(optional<_Up>&& __u)
+    {
+        if (__u) {
+            if (this->_M_is_engaged()) {
+                this->_M_get() = std::move(*__u);
+            } else {
+                this->_M_construct(std::move(*__u));
+            }
+        } else {
+            this->_M_reset();
+        }
+
+        return *this;
+    }
+
+    template<typename... _Args>
+    constexpr
+    enable_if_t<is_constructible_v<_Tp, _Args&&...>, _Tp&>
+    emplace(_Args&&... __args)
+    {
+        this->_M_reset();
+        this->_M_construct(std::forward<_Args>(__args)...);
+        return this->_M_get();
+    }
+
+    template<typename _Up, typename... _Args>
+    constexpr
+    enable_if_t<is_constructible_v<_Tp, initializer_list<_Up>&,
+                                   _Args&&...>, _Tp&>
+    emplace(initializer_list<_Up> __il, _Args&&... __args)
+    {
+        this->_M_reset();
+        this->_M_construct(__il, std::forward<_Args>(__args)...);
+        return this->_M_get();
+    }
+
+    // Destructor is implicit, implemented in _Optional_base.
+
+    // Swap.
+    constexpr void
+    swap(optional& __other)
+    noexcept(is_nothrow_move_constructible_v<_Tp>
+             && is_nothrow_swappable_v<_Tp>)
+    {
+        using std::swap;
+
+        if (this->_M_is_engaged() && __other._M_is_engaged()) {
+            swap(this->_M_get(), __other._M_get());
+        } else if (this->_M_is_engaged()) {
+            __other._M_construct(std::move(this->_M_get()));
+            this->_M_destruct();
+        } else if (__other._M_is_engaged()) {
+            this->_M_construct(std::move(__other._M_get()));
+            __other._M_destruct();
+        }
+    }
+
+    // Observers.
+    constexpr const _Tp*
+    operator->() const
+    {
+        return std::__addressof(this->_M_get());
+    }
+
+    constexpr _Tp*
+    operator->()
+    {
+        return std::__addressof(this->_M_get());
+    }
+
+    constexpr const _Tp&
+    operator*() const&
+    {
+        return this->_M_get();
+    }
+
+    constexpr _Tp&
+    operator*()&
+    { return this->_M_get(); }
+
+    constexpr _Tp&&
+    operator*()&&
+    { return std::move(this->_M_get()); }
+
+    constexpr const _Tp&&
+    operator*() const&&
+    {
+        return std::move(this->_M_get());
+    }
+
+    constexpr explicit operator bool() const noexcept
+    {
+        return this->_M_is_engaged();
+    }
+
+    constexpr bool has_value() const noexcept
+    {
+        return this->_M_is_engaged();
+    }
+
+    constexpr const _Tp&
+    value() const&
+    {
+        return this->_M_is_engaged()
+               ? this->_M_get()
+               : (__throw_bad_optional_access(), this->_M_get());
+    }
+
+    constexpr _Tp&
+    value()& {
+        return this->_M_is_engaged()
+        ? this->_M_get()
+        : (__throw_bad_optional_access(), this->_M_get());
+    }
+
+    constexpr _Tp&&
+    value()&& {
+        return this->_M_is_engaged()
+        ? std::move(this->_M_get())
+        : (__throw_bad_optional_access(), std::move(this->_M_get()));
+    }
+
+    constexpr const _Tp&&
+    value() const&&
+    {
+        return this->_M_is_engaged()
+               ? std::move(this->_M_get())
+               : (__throw_bad_optional_access(), std::move(this->_M_get()));
+    }
+
+    template<typename _Up>
+    constexpr _Tp
+    value_or(_Up&& __u) const&
+    {
+        static_assert(is_copy_constructible_v<_Tp>);
+        static_assert(is_convertible_v<_Up&&, _Tp>);
+
+        return this->_M_is_engaged()
+               ? this->_M_get() : static_cast<_Tp>(std::forward<_Up>(__u));
+    }
+
+    template<typename _Up>
+    constexpr _Tp
+    value_or(_Up&& __u) && {
+        static_assert(is_move_constructible_v<_Tp>);
+        static_assert(is_convertible_v<_Up&&, _Tp>);
+
+        return this->_M_is_engaged()
+        ? std::move(this->_M_get())
+        : static_cast<_Tp>(std::forward<_Up>(__u));
+    }
+
+    // Monadic operations.
+    template<typename _Fn>
+    constexpr auto
+    and_then(_Fn&& __f) &
+    {
+        using _Up = remove_cvref_t<invoke_result_t<_Fn, _Tp&>>;
+        static_assert(__is_optional_v<_Up>);
+        if (this->_M_is_engaged()) {
+            return std::__invoke(std::forward<_Fn>(__f), this->_M_get());
+        }
+        return _Up();
+    }
+
+    template<typename _Fn>
+    constexpr auto
+    and_then(_Fn&& __f) const&
+    {
+        using _Up = remove_cvref_t<invoke_result_t<_Fn, const _Tp&>>;
+        static_assert(__is_optional_v<_Up>);
+        if (this->_M_is_engaged()) {
+            return std::__invoke(std::forward<_Fn>(__f), this->_M_get());
+        }
+        return _Up();
+    }
+
+    template<typename _Fn>
+    constexpr auto
+    and_then(_Fn&& __f) &&
+    {
+        using _Up = remove_cvref_t<invoke_result_t<_Fn, _Tp>>;
+        static_assert(__is_optional_v<_Up>);
+        if (this->_M_is_engaged()) {
+            return std::__invoke(std::forward<_Fn>(__f),
+                                 std::move(this->_M_get()));
+        }
+        return _Up();
+    }
+
+    template<typename _Fn>
+    constexpr auto
+    and_then(_Fn&& __f) const&&
+    {
+        using _Up = remove_cvref_t<invoke_result_t<_Fn, const _Tp>>;
+        static_assert(__is_optional_v<_Up>);
+        if (this->_M_is_engaged()) {
+            return std::__invoke(std::forward<_Fn>(__f),
+                                 std::move(this->_M_get()));
+        }
+        return _Up();
+    }
+
+    // The result of __f initializes the new contained value directly,
+    // see _Optional_base::_M_apply.
+    template<typename _Fn>
+    constexpr auto
+    transform(_Fn&& __f) &
+    {
+        using _Up = remove_cv_t<invoke_result_t<_Fn, _Tp&>>;
+        if (this->_M_is_engaged()) {
+            return optional<_Up>(_Optional_func<_Fn>{__f}, this->_M_get());
+        }
+        return optional<_Up>();
+    }
+
+    template<typename _Fn>
+    constexpr auto
+    transform(_Fn&& __f) const&
+    {
+        using _Up = remove_cv_t<invoke_result_t<_Fn, const _Tp&>>;
+        if (this->_M_is_engaged()) {
+            return optional<_Up>(_Optional_func<_Fn>{__f}, this->_M_get());
+        }
+        return optional<_Up>();
+    }
+
+    template<typename _Fn>
+    constexpr auto
+    transform(_Fn&& __f) &&
+    {
+        using _Up = remove_cv_t<invoke_result_t<_Fn, _Tp>>;
+        if (this->_M_is_engaged()) {
+            return optional<_Up>(_Optional_func<_Fn>{__f},
+                                 std::move(this->_M_get()));
+        }
+        return optional<_Up>();
+    }
+
+    template<typename _Fn>
+    constexpr auto
+    transform(_Fn&& __f) const&&
+    {
+        using _Up = remove_cv_t<invoke_result_t<_Fn, const _Tp>>;
+        if (this->_M_is_engaged()) {
+            return optional<_Up>(_Optional_func<_Fn>{__f},
+                                 std::move(this->_M_get()));
+        }
+        return optional<_Up>();
+    }
+
+    template<typename _Fn>
+    constexpr optional
+    or_else(_Fn&& __f) const&
+    {
+        static_assert(is_copy_constructible_v<_Tp>);
+        static_assert(is_same_v<remove_cvref_t<invoke_result_t<_Fn>>,
+                                optional>);
+        if (this->_M_is_engaged()) {
+            return *this;
+        }
+        return std::forward<_Fn>(__f)();
+    }
+
+    template<typename _Fn>
+    constexpr optional
+    or_else(_Fn&& __f) &&
+    {
+        static_assert(is_move_constructible_v<_Tp>);
+        static_assert(is_same_v<remove_cvref_t<invoke_result_t<_Fn>>,
+                                optional>);
+        if (this->_M_is_engaged()) {
+            return std::move(*this);
+        }
+        return std::forward<_Fn>(__f)();
+    }
+
+    constexpr void reset() noexcept
+    {
+        this->_M_reset();
+    }
+
+private:
+    template<typename _Up> friend class optional;
+    template<typename _Res> friend struct _Optional_collect_sink;
+
+    template<typename _Fn, typename... _Args>
+    explicit constexpr
+    optional(_Optional_func<_Fn> __f, _Args&&... __args)
+    {
+        this->_M_apply(__f, std::forward<_Args>(__args)...);
+    }
+};
+
+// Swap and creation functions.
+
+// _GLIBCXX_RESOLVE_LIB_DEFECTS
+// 2748. swappable traits for optionals
+template<typename _Tp>
+constexpr inline enable_if_t<is_move_constructible_v<_Tp> && is_swappable_v<_Tp>>
+swap(optional<_Tp>& __lhs, optional<_Tp>& __rhs)
+noexcept(noexcept(__lhs.swap(__rhs))) {
+    __lhs.swap(__rhs);
+}
+
+template<typename _Tp>
+enable_if_t<!(is_move_constructible_v<_Tp> && is_swappable_v<_Tp>)>
+swap(optional<_Tp>&, optional<_Tp>&) = delete;
+
+template<typename _Tp>
+constexpr optional<decay_t<_Tp>>
+make_optional(_Tp&& __t) {
+    return optional<decay_t<_Tp>> { std::forward<_Tp>(__t) };
+}
+
+template<typename _Tp, typename ..._Args>
+constexpr optional<_Tp>
+make_optional(_Args&&... __args) {
+    return optional<_Tp> { in_place, std::forward<_Args>(__args)... };
+}
+
+template<typename _Tp, typename _Up, typename ..._Args>
+constexpr optional<_Tp>
+make_optional(initializer_list<_Up> __il, _Args&&... __args) {
+    return optional<_Tp> { in_place, __il, std::forward<_Args>(__args)... };
+}
+
+/// @}
+
+#if __cpp_deduction_guides >= 201606
+template <typename _Tp> optional(_Tp) -> optional<_Tp>;
+#endif
+
+_GLIBCXX_END_NAMESPACE_VERSION
+} // namespace std
+
+#endif // C++17
+
+#endif // _GLIBCXX_OPTIONAL_CORE
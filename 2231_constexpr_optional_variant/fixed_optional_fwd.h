@@ -0,0 +1,42 @@
+#ifndef _GLIBCXX_OPTIONAL_FWD
+#define _GLIBCXX_OPTIONAL_FWD 1
+
+#if __cplusplus >= 201703L
+
+#include <bits/c++config.h>
+
+// Declarations of optional and its helper types, for translation units that
+// only name them. Include fixed_optional_core.h to create and access
+// optionals, and fixed_optional.h for comparisons, hash and optional_ops.
+
+namespace std _GLIBCXX_VISIBILITY(default)
+{
+_GLIBCXX_BEGIN_NAMESPACE_VERSION
+
+template<typename _Tp>
+class optional;
+
+/// Tag type to disengage optional objects.
+struct nullopt_t {
+    // Do not user-declare default constructor at all for
+    // optional_value = {} syntax to work.
+    // nullopt_t() = delete;
+
+    // Used for constructing nullopt.
+    enum class _Construct { _Token };
+
+    // Must be constexpr for nullopt_t to be literal.
+    explicit constexpr nullopt_t(_Construct) { }
+};
+
+/// Tag to disengage optional objects.
+inline constexpr nullopt_t nullopt { nullopt_t::_Construct::_Token };
+
+class bad_optional_access;
+
+_GLIBCXX_END_NAMESPACE_VERSION
+} // namespace std
+
+#endif // C++17
+
+#endif // _GLIBCXX_OPTIONAL_FWD
@@ -0,0 +1,605 @@
+#ifndef _GLIBCXX_OPTIONAL_OPS
+#define _GLIBCXX_OPTIONAL_OPS 1
+
+#if __cplusplus >= 201703L
+
+#include <bits/functional_hash.h>
+#if __cplusplus > 201703L
+# include <compare>
+#endif
+#include "fixed_optional_core.h"
+
+// Comparisons, hash support and the optional_ops pipeline for optional.
+
+namespace std _GLIBCXX_VISIBILITY(default)
+{
+_GLIBCXX_BEGIN_NAMESPACE_VERSION
+
+template<typename _Tp>
+using __optional_relop_t =
+enable_if_t<is_convertible<_Tp, bool>::value, bool>;
+
+// Comparisons between optional values.
+template<typename _Tp, typename _Up>
+constexpr auto
+operator==(const optional<_Tp>& __lhs, const optional<_Up>& __rhs)
+-> __optional_relop_t<decltype(declval<_Tp>() == declval<_Up>())> {
+    return static_cast<bool>(__lhs) == static_cast<bool>(__rhs)
+    && (!__lhs || *__lhs == *__rhs);
+}
+
+template<typename _Tp, typename _Up>
+constexpr auto
+operator!=(const optional<_Tp>& __lhs, const optional<_Up>& __rhs)
+-> __optional_relop_t<decltype(declval<_Tp>() != declval<_Up>())> {
+    return static_cast<bool>(__lhs) != static_cast<bool>(__rhs)
+    || (static_cast<bool>(__lhs) && *__lhs != *__rhs);
+}
+
+template<typename _Tp, typename _Up>
+constexpr auto
+operator<(const optional<_Tp>& __lhs, const optional<_Up>& __rhs)
+-> __optional_relop_t<decltype(declval<_Tp>() < declval<_Up>())> {
+    return static_cast<bool>(__rhs) && (!__lhs || *__lhs < *__rhs);
+}
+
+template<typename _Tp, typename _Up>
+constexpr auto
+operator>(const optional<_Tp>& __lhs, const optional<_Up>& __rhs)
+-> __optional_relop_t<decltype(declval<_Tp>() > declval<_Up>())> {
+    return static_cast<bool>(__lhs) && (!__rhs || *__lhs > *__rhs);
+}
+
+template<typename _Tp, typename _Up>
+constexpr auto
+operator<=(const optional<_Tp>& __lhs, const optional<_Up>& __rhs)
+-> __optional_relop_t<decltype(declval<_Tp>() <= declval<_Up>())> {
+    return !__lhs || (static_cast<bool>(__rhs) && *__lhs <= *__rhs);
+}
+
+template<typename _Tp, typename _Up>
+constexpr auto
+operator>=(const optional<_Tp>& __lhs, const optional<_Up>& __rhs)
+-> __optional_relop_t<decltype(declval<_Tp>() >= declval<_Up>())> {
+    return !__rhs || (static_cast<bool>(__lhs) && *__lhs >= *__rhs);
+}
+
+#ifdef __cpp_lib_three_way_comparison
+template<typename _Tp, three_way_comparable_with<_Tp> _Up>
+constexpr compare_three_way_result_t<_Tp, _Up>
+operator<=>(const optional<_Tp>& __x, const optional<_Up>& __y) {
+    return __x && __y ? *__x <=> *__y : bool(__x) <=> bool(__y);
+}
+#endif
+
+// Comparisons with nullopt.
+template<typename _Tp>
+constexpr bool
+operator==(const optional<_Tp>& __lhs, nullopt_t) noexcept {
+    return !__lhs;
+}
+
+#ifdef __cpp_lib_three_way_comparison
+template<typename _Tp>
+constexpr strong_ordering
+operator<=>(const optional<_Tp>& __x, nullopt_t) noexcept {
+    return bool(__x) <=> false;
+}
+#else
+template<typename _Tp>
+constexpr bool
+operator==(nullopt_t, const optional<_Tp>& __rhs) noexcept {
+    return !__rhs;
+}
+
+template<typename _Tp>
+constexpr bool
+operator!=(const optional<_Tp>& __lhs, nullopt_t) noexcept {
+    return static_cast<bool>(__lhs);
+}
+
+template<typename _Tp>
+constexpr bool
+operator!=(nullopt_t, const optional<_Tp>& __rhs) noexcept {
+    return static_cast<bool>(__rhs);
+}
+
+template<typename _Tp>
+constexpr bool
+operator<(const optional<_Tp>& /* __lhs */, nullopt_t) noexcept {
+    return false;
+}
+
+template<typename _Tp>
+constexpr bool
+operator<(nullopt_t, const optional<_Tp>& __rhs) noexcept {
+    return static_cast<bool>(__rhs);
+}
+
+template<typename _Tp>
+constexpr bool
+operator>(const optional<_Tp>& __lhs, nullopt_t) noexcept {
+    return static_cast<bool>(__lhs);
+}
+
+template<typename _Tp>
+constexpr bool
+operator>(nullopt_t, const optional<_Tp>& /* __rhs */) noexcept {
+    return false;
+}
+
+template<typename _Tp>
+constexpr bool
+operator<=(const optional<_Tp>& __lhs, nullopt_t) noexcept {
+    return !__lhs;
+}
+
+template<typename _Tp>
+constexpr bool
+operator<=(nullopt_t, const optional<_Tp>& /* __rhs */) noexcept {
+    return true;
+}
+
+template<typename _Tp>
+constexpr bool
+operator>=(const optional<_Tp>& /* __lhs */, nullopt_t) noexcept {
+    return true;
+}
+
+template<typename _Tp>
+constexpr bool
+operator>=(nullopt_t, const optional<_Tp>& __rhs) noexcept {
+    return !__rhs;
+}
+#endif // three-way-comparison
+
+// Comparisons with value type.
+template<typename _Tp, typename _Up>
+constexpr auto
+operator==(const optional<_Tp>& __lhs, const _Up& __rhs)
+-> __optional_relop_t<decltype(declval<_Tp>() == declval<_Up>())>
+{ return __lhs && *__lhs == __rhs; }
+
+template<typename _Tp, typename _Up>
+constexpr auto
+operator==(const _Up& __lhs, const optional<_Tp>& __rhs)
+-> __optional_relop_t<decltype(declval<_Up>() == declval<_Tp>())>
+{ return __rhs && __lhs == *__rhs; }
+
+template<typename _Tp, typename _Up>
+constexpr auto
+operator!=(const optional<_Tp>& __lhs, const _Up& __rhs)
+-> __optional_relop_t<decltype(declval<_Tp>() != declval<_Up>())>
+{ return !__lhs || *__lhs != __rhs; }
+
+template<typename _Tp, typename _Up>
+constexpr auto
+operator!=(const _Up& __lhs, const optional<_Tp>& __rhs)
+-> __optional_relop_t<decltype(declval<_Up>() != declval<_Tp>())>
+{ return !__rhs || __lhs != *__rhs; }
+
+template<typename _Tp, typename _Up>
+constexpr auto
+operator<(const optional<_Tp>& __lhs, const _Up& __rhs)
+         -> __optional_relop_t<decltype(declval<_Tp>() < declval<_Up>())>
+{ return !__lhs || *__lhs < __rhs; }
+
+template<typename _Tp, typename _Up>
+constexpr auto
+operator<(const _Up& __lhs, const optional<_Tp>& __rhs)
+         -> __optional_relop_t<decltype(declval<_Up>() < declval<_Tp>())>
+{ return __rhs && __lhs < *__rhs; }
+
+template<typename _Tp, typename _Up>
+constexpr auto
+operator>(const optional<_Tp>& __lhs, const _Up& __rhs)
+-> __optional_relop_t<decltype(declval<_Tp>() > declval<_Up>())>
+{ return __lhs && *__lhs > __rhs; }
+
+template<typename _Tp, typename _Up>
+constexpr auto
+operator>(const _Up& __lhs, const optional<_Tp>& __rhs)
+-> __optional_relop_t<decltype(declval<_Up>() > declval<_Tp>())>
+{ return !__rhs || __lhs > *__rhs; }
+
+template<typename _Tp, typename _Up>
+constexpr auto
+operator<=(const optional<_Tp>& __lhs, const _Up& __rhs)
+         -> __optional_relop_t<decltype(declval<_Tp>() <= declval<_Up>())>
+{ return !__lhs || *__lhs <= __rhs; }
+
+template<typename _Tp, typename _Up>
+constexpr auto
+operator<=(const _Up& __lhs, const optional<_Tp>& __rhs)
+         -> __optional_relop_t<decltype(declval<_Up>() <= declval<_Tp>())>
+{ return __rhs && __lhs <= *__rhs; }
+
+template<typename _Tp, typename _Up>
+constexpr auto
+operator>=(const optional<_Tp>& __lhs, const _Up& __rhs)
+-> __optional_relop_t<decltype(declval<_Tp>() >= declval<_Up>())>
+{ return __lhs && *__lhs >= __rhs; }
+
+template<typename _Tp, typename _Up>
+constexpr auto
+operator>=(const _Up& __lhs, const optional<_Tp>& __rhs)
+-> __optional_relop_t<decltype(declval<_Up>() >= declval<_Tp>())>
+{ return !__rhs || __lhs >= *__rhs; }
+
+#ifdef __cpp_lib_three_way_comparison
+template<typename _Tp, typename _Up>
+constexpr compare_three_way_result_t<_Tp, _Up>
+operator<=>(const optional<_Tp>& __x, const _Up& __v) {
+    return bool(__x) ? *__x <=> __v : strong_ordering::less;
+}
+#endif
+
+// Lazy pipeline form of the monadic operations:
+//
+//   __o | optional_ops::transform(__f) | optional_ops::and_then(__g)
+//       | optional_ops::value_or_else(__h)
+//
+// Each | only records a stage. Nothing is evaluated until the pipeline
+// reaches a terminal (value_or, value_or_else, or conversion to optional).
+// Evaluation is in continuation-passing style: the engaged flag of the
+// source is tested once, every stage hands the next one a thunk producing
+// its value, and the terminal initializes the result from the last thunk.
+// No intermediate optional is created for transform stages and a prvalue
+// result is constructed directly in the final object. and_then and
+// or_else stages branch again only on the optional their callable returns.
+//
+// A pipeline refers to an lvalue source and holds an rvalue source by
+// value, moved in, so a pipeline over a temporary can be stored and run
+// later; one over an lvalue must not outlive it.
+
+struct _Optional_transform_tag { };
+struct _Optional_and_then_tag { };
+struct _Optional_or_else_tag { };
+struct _Optional_value_or_tag { };
+struct _Optional_value_or_else_tag { };
+
+// An intermediate stage, produced by optional_ops::transform etc.
+template<typename _Tag, typename _Fn>
+struct _Optional_stage {
+    _Fn _M_f;
+};
+
+// A terminal, produced by optional_ops::value_or and value_or_else.
+template<typename _Tag, typename _Up>
+struct _Optional_terminal {
+    _Up _M_u;
+};
+
+// The continuation that applies one stage before passing control to _Kont.
+template<typename _Tag, typename _Fn, typename _Kont>
+struct _Optional_kont;
+
+template<typename _Fn, typename _Kont>
+struct _Optional_kont<_Optional_transform_tag, _Fn, _Kont> {
+    _Fn& _M_f;
+    _Kont& _M_k;
+
+    template<typename _Thunk>
+    constexpr auto
+    _M_value(_Thunk&& __t)
+    {
+        return _M_k._M_value([&]() -> decltype(auto) {
+            return std::__invoke(std::move(_M_f), __t());
+        });
+    }
+
+    constexpr auto
+    _M_empty()
+    {
+        return _M_k._M_empty();
+    }
+};
+
+template<typename _Fn, typename _Kont>
+struct _Optional_kont<_Optional_and_then_tag, _Fn, _Kont> {
+    _Fn& _M_f;
+    _Kont& _M_k;
+
+    template<typename _Thunk>
+    constexpr auto
+    _M_value(_Thunk&& __t)
+    {
+        auto&& __r = std::__invoke(std::move(_M_f), __t());
+        if (__r) {
+            return _M_k._M_value([&]() -> decltype(auto) {
+                return *std::forward<decltype(__r)>(__r);
+            });
+        }
+        return _M_k._M_empty();
+    }
+
+    constexpr auto
+    _M_empty()
+    {
+        return _M_k._M_empty();
+    }
+};
+
+template<typename _Fn, typename _Kont>
+struct _Optional_kont<_Optional_or_else_tag, _Fn, _Kont> {
+    _Fn& _M_f;
+    _Kont& _M_k;
+
+    template<typename _Thunk>
+    constexpr auto
+    _M_value(_Thunk&& __t)
+    {
+        return _M_k._M_value(__t);
+    }
+
+    constexpr auto
+    _M_empty()
+    {
+        auto&& __r = std::__invoke(std::move(_M_f));
+        if (__r) {
+            return _M_k._M_value([&]() -> decltype(auto) {
+                return *std::forward<decltype(__r)>(__r);
+            });
+        }
+        return _M_k._M_empty();
+    }
+};
+
+// Terminal continuations, which construct the result of the pipeline.
+template<typename _Res>
+struct _Optional_collect_sink {
+    template<typename _Thunk>
+    constexpr optional<_Res>
+    _M_value(_Thunk&& __t)
+    {
+        return optional<_Res>(_Optional_func<_Thunk>{__t});
+    }
+
+    constexpr optional<_Res>
+    _M_empty()
+    {
+        return optional<_Res>();
+    }
+};
+
+template<typename _Res, typename _Up>
+struct _Optional_value_or_sink {
+    _Up& _M_u;
+
+    template<typename _Thunk>
+    constexpr _Res
+    _M_value(_Thunk&& __t)
+    {
+        return static_cast<_Res>(__t());
+    }
+
+    constexpr _Res
+    _M_empty()
+    {
+        return static_cast<_Res>(std::forward<_Up>(_M_u));
+    }
+};
+
+template<typename _Res, typename _Fn>
+struct _Optional_value_or_else_sink {
+    _Fn& _M_f;
+
+    template<typename _Thunk>
+    constexpr _Res
+    _M_value(_Thunk&& __t)
+    {
+        return static_cast<_Res>(__t());
+    }
+
+    constexpr _Res
+    _M_empty()
+    {
+        return static_cast<_Res>(std::__invoke(std::move(_M_f)));
+    }
+};
+
+// The head of a pipeline. _Opt is an lvalue reference to the source
+// optional, an rvalue reference when the pipeline is run at once, or the
+// optional type itself when a stored pipeline owns it.
+template<typename _Opt>
+struct _Optional_pipe_source {
+    using _Ref = decltype(*std::declval<_Opt>());
+
+    _Opt _M_opt;
+
+    template<typename _Kont>
+    constexpr auto
+    _M_run(_Kont& __k)
+    {
+        if (_M_opt) {
+            return __k._M_value([this]() -> decltype(auto) {
+                return *std::forward<_Opt>(_M_opt);
+            });
+        }
+        return __k._M_empty();
+    }
+};
+
+template<typename _Prev, typename _Tag, typename _Fn>
+struct _Optional_pipe_ref;
+
+template<typename _Prev, typename _Fn>
+struct _Optional_pipe_ref<_Prev, _Optional_transform_tag, _Fn> {
+    using type = invoke_result_t<_Fn, typename _Prev::_Ref>;
+};
+
+template<typename _Prev, typename _Fn>
+struct _Optional_pipe_ref<_Prev, _Optional_and_then_tag, _Fn> {
+    using _Up = invoke_result_t<_Fn, typename _Prev::_Ref>;
+    static_assert(__is_optional_v<remove_cvref_t<_Up>>);
+    using type = decltype(*std::declval<_Up>());
+};
+
+template<typename _Prev, typename _Fn>
+struct _Optional_pipe_ref<_Prev, _Optional_or_else_tag, _Fn> {
+    static_assert(is_same_v<
+                  remove_cvref_t<invoke_result_t<_Fn>>,
+                  optional<remove_cvref_t<typename _Prev::_Ref>>>);
+    using type = typename _Prev::_Ref;
+};
+
+// A pipeline with at least one stage.
+template<typename _Prev, typename _Tag, typename _Fn>
+struct _Optional_pipe {
+    using _Ref = typename _Optional_pipe_ref<_Prev, _Tag, _Fn>::type;
+    using value_type = remove_cvref_t<_Ref>;
+
+    _Prev _M_prev;
+    _Fn _M_f;
+
+    template<typename _Kont>
+    constexpr auto
+    _M_run(_Kont& __k)
+    {
+        _Optional_kont<_Tag, _Fn, _Kont> __kont{_M_f, __k};
+        return _M_prev._M_run(__kont);
+    }
+
+    constexpr
+    operator optional<value_type>() &&
+    {
+        _Optional_collect_sink<value_type> __sink;
+        return _M_run(__sink);
+    }
+};
+
+template<typename _Tp>
+inline constexpr bool __is_optional_pipe_v = false;
+
+template<typename _Prev, typename _Tag, typename _Fn>
+inline constexpr bool __is_optional_pipe_v<
+    _Optional_pipe<_Prev, _Tag, _Fn>> = true;
+
+template<typename _Tp>
+concept __optional_pipe_head = __is_optional_v<remove_cvref_t<_Tp>>;
+
+template<typename _Opt, typename _Tag, typename _Fn>
+requires __optional_pipe_head<_Opt>
+constexpr auto
+operator|(_Opt&& __o, _Optional_stage<_Tag, _Fn> __s)
+{
+    using _Src = _Optional_pipe_source<_Opt>;
+    return _Optional_pipe<_Src, _Tag, _Fn> {
+        _Src{std::forward<_Opt>(__o)}, std::move(__s._M_f)
+    };
+}
+
+template<typename _Prev, typename _Tp, typename _Gp,
+         typename _Tag, typename _Fn>
+constexpr auto
+operator|(_Optional_pipe<_Prev, _Tp, _Gp>&& __p,
+          _Optional_stage<_Tag, _Fn> __s)
+{
+    return _Optional_pipe<_Optional_pipe<_Prev, _Tp, _Gp>, _Tag, _Fn> {
+        std::move(__p), std::move(__s._M_f)
+    };
+}
+
+template<typename _Pipe, typename _Up>
+requires __optional_pipe_head<_Pipe>
+         || __is_optional_pipe_v<remove_cvref_t<_Pipe>>
+constexpr auto
+operator|(_Pipe&& __p, _Optional_terminal<_Optional_value_or_tag, _Up> __t)
+{
+    using _Res = typename remove_cvref_t<_Pipe>::value_type;
+    _Optional_value_or_sink<_Res, _Up> __sink{__t._M_u};
+    if constexpr (__optional_pipe_head<_Pipe>) {
+        return _Optional_pipe_source<_Pipe&&>{std::forward<_Pipe>(__p)}
+               ._M_run(__sink);
+    } else {
+        return __p._M_run(__sink);
+    }
+}
+
+template<typename _Pipe, typename _Fn>
+requires __optional_pipe_head<_Pipe>
+         || __is_optional_pipe_v<remove_cvref_t<_Pipe>>
+constexpr auto
+operator|(_Pipe&& __p,
+          _Optional_terminal<_Optional_value_or_else_tag, _Fn> __t)
+{
+    using _Res = typename remove_cvref_t<_Pipe>::value_type;
+    _Optional_value_or_else_sink<_Res, _Fn> __sink{__t._M_u};
+    if constexpr (__optional_pipe_head<_Pipe>) {
+        return _Optional_pipe_source<_Pipe&&>{std::forward<_Pipe>(__p)}
+               ._M_run(__sink);
+    } else {
+        return __p._M_run(__sink);
+    }
+}
+
+namespace optional_ops
+{
+template<typename _Fn>
+constexpr _Optional_stage<_Optional_transform_tag, decay_t<_Fn>>
+transform(_Fn&& __f) {
+    return { std::forward<_Fn>(__f) };
+}
+
+template<typename _Fn>
+constexpr _Optional_stage<_Optional_and_then_tag, decay_t<_Fn>>
+and_then(_Fn&& __f) {
+    return { std::forward<_Fn>(__f) };
+}
+
+template<typename _Fn>
+constexpr _Optional_stage<_Optional_or_else_tag, decay_t<_Fn>>
+or_else(_Fn&& __f) {
+    return { std::forward<_Fn>(__f) };
+}
+
+template<typename _Up>
+constexpr _Optional_terminal<_Optional_value_or_tag, _Up&&>
+value_or(_Up&& __u) {
+    return { std::forward<_Up>(__u) };
+}
+
+template<typename _Fn>
+constexpr _Optional_terminal<_Optional_value_or_else_tag, decay_t<_Fn>>
+value_or_else(_Fn&& __f) {
+    return { std::forward<_Fn>(__f) };
+}
+} // namespace optional_ops
+
+// Hash.
+
+template<typename _Tp, typename _Up = remove_const_t<_Tp>,
+         bool = __poison_hash<_Up>::__enable_hash_call>
+struct __optional_hash_call_base {
+    size_t
+    operator()(const optional<_Tp>& __t) const
+    noexcept(noexcept(hash<_Up> {}(*__t)))
+    {
+        // We pick an arbitrary hash for disengaged optionals which hopefully
+        // usual values of _Tp won't typically hash to.
+        constexpr size_t __magic_disengaged_hash = static_cast<size_t>(-3333);
+        return __t ? hash<_Up> {}(*__t) : __magic_disengaged_hash;
+    }
+};
+
+template<typename _Tp, typename _Up>
+struct __optional_hash_call_base<_Tp, _Up, false> {};
+
+template<typename _Tp>
+struct hash<optional<_Tp>>
+: private __poison_hash<remove_const_t<_Tp>>,
+public __optional_hash_call_base<_Tp> {
+    using result_type [[__deprecated__]] = size_t;
+    using argument_type [[__deprecated__]] = optional<_Tp>;
+};
+
+template<typename _Tp>
+struct __is_fast_hash<hash<optional<_Tp>>> : __is_fast_hash<hash<_Tp>> {
+};
+
+_GLIBCXX_END_NAMESPACE_VERSION
+} // namespace std
+
+#endif // C++17
+
+#endif // _GLIBCXX_OPTIONAL_OPS
@@ -0,0 +1,12 @@
+// Module interface unit for variant. It re-exports the header unit of
+// fixed_variant.h, so an importer sees exactly what the header declares.
+// With GCC, build the header unit before the module:
+//
+//   g++ -std=c++20 -fmodules-ts -x c++-header fixed_variant.h
+//   g++ -std=c++20 -fmodules-ts -x c++ -c fixed_variant.cppm
+//
+// and then write `import fixed_variant;` in place of the #include.
+
+export module fixed_variant;
+
+export import "fixed_variant.h";
@@ -0,0 +1,44 @@
+#ifndef _GLIBCXX_VARIANT_FWD
+#define _GLIBCXX_VARIANT_FWD 1
+
+#if __cplusplus >= 201703L
+
+#include <bits/c++config.h>
+
+// Declarations of variant and its helper types, for translation units that
+// only name them. Include fixed_variant_core.h to create and access
+// variants, and fixed_variant.h for visit, comparisons and hash as well.
+
+namespace std _GLIBCXX_VISIBILITY(default)
+{
+_GLIBCXX_BEGIN_NAMESPACE_VERSION
+
+template<typename... _Types> class variant;
+
+template<typename _Variant>
+struct variant_size;
+
+template<size_t _Np, typename _Variant>
+struct variant_alternative;
+
+inline constexpr size_t variant_npos = -1;
+
+struct monostate { };
+
+// Specialize as true for an empty type whose values all compare equal,
+// such as a tag type with defaulted comparisons. Comparing two variants
+// whose alternatives are all such types compares their indices only.
+template<typename _Tp>
+inline constexpr bool enable_variant_index_compare = false;
+
+template<>
+inline constexpr bool enable_variant_index_compare<monostate> = true;
+
+class bad_variant_access;
+
+_GLIBCXX_END_NAMESPACE_VERSION
+} // namespace std
+
+#endif // C++17
+
+#endif // _GLIBCXX_VARIANT_FWD
@@ -0,0 +1,221 @@
+#ifndef _GLIBCXX_VARIANT_OPS
+#define _GLIBCXX_VARIANT_OPS 1
+
+#if __cplusplus >= 201703L
+
+#include <bits/functional_hash.h>
+#if __cplusplus > 201703L
+# include <compare>
+#endif
+#include "fixed_variant_core.h"
+
+// std::visit, comparisons and hash support for variant and monostate.
+
+namespace std _GLIBCXX_VISIBILITY(default)
+{
+_GLIBCXX_BEGIN_NAMESPACE_VERSION
+
+namespace __detail
+{
+namespace __variant
+{
+template<size_t _Np, typename _Tp>
+struct _Base_dedup : public _Tp { };
+
+template<typename _Variant, typename __indices>
+struct _Variant_hash_base;
+
+template<typename... _Types, size_t... __indices>
+struct _Variant_hash_base<variant<_Types...>,
+                          std::index_sequence<__indices...>>
+: _Base_dedup<__indices, __poison_hash<remove_const_t<_Types>>>... { };
+
+} // namespace __variant
+} // namespace __detail
+
+#define _VARIANT_RELATION_FUNCTION_TEMPLATE(__OP, __NAME) \
+  template<typename... _Types> \
+    constexpr bool operator __OP(const variant<_Types...>& __lhs, \
+				 const variant<_Types...>& __rhs) \
+    { \
+      if constexpr (__detail::__variant::__index_compare_alts<_Types...>) \
+        return __lhs.index() __OP __rhs.index(); \
+      bool __ret = true; \
+      __detail::__variant::__raw_idx_visit( \
+        [&__ret, &__lhs] (auto&& __rhs_mem, auto __rhs_index) mutable \
+        { \
+	  if constexpr (__rhs_index != variant_npos) \
+	    { \
+	      if (__lhs.index() == __rhs_index) \
+	        { \
+		  auto& __this_mem = std::get<__rhs_index>(__lhs);	\
+                  __ret = __this_mem __OP __rhs_mem; \
+                } \
+	      else \
+		__ret = (__lhs.index() + 1) __OP (__rhs_index + 1); \
+            } \
+          else \
+            __ret = (__lhs.index() + 1) __OP (__rhs_index + 1); \
+	}, __rhs); \
+      return __ret; \
+    }
+
+_VARIANT_RELATION_FUNCTION_TEMPLATE(<, less)
+_VARIANT_RELATION_FUNCTION_TEMPLATE(<=, less_equal)
+_VARIANT_RELATION_FUNCTION_TEMPLATE(==, equal)
+_VARIANT_RELATION_FUNCTION_TEMPLATE(!=, not_equal)
+_VARIANT_RELATION_FUNCTION_TEMPLATE(>=, greater_equal)
+_VARIANT_RELATION_FUNCTION_TEMPLATE(>, greater)
+
+#undef _VARIANT_RELATION_FUNCTION_TEMPLATE
+
+constexpr bool operator==(monostate, monostate) noexcept {
+    return true;
+}
+
+#ifdef __cpp_lib_three_way_comparison
+template<typename... _Types>
+requires (three_way_comparable<_Types> && ...)
+constexpr
+common_comparison_category_t<compare_three_way_result_t<_Types>...>
+operator<=>(const variant<_Types...>& __v, const variant<_Types...>& __w) {
+    if constexpr (__detail::__variant::__index_compare_alts<_Types...>) {
+        return __v.index() <=> __w.index();
+    }
+
+    common_comparison_category_t<compare_three_way_result_t<_Types>...> __ret
+    = strong_ordering::equal;
+
+    __detail::__variant::__raw_idx_visit(
+    [&__ret, &__v] (auto&& __w_mem, auto __w_index) mutable {
+        if constexpr (__w_index != variant_npos)
+        {
+            if (__v.index() == __w_index) {
+                auto& __this_mem = std::get<__w_index>(__v);
+                __ret = __this_mem <=> __w_mem;
+                return;
+            }
+        }
+        __ret = (__v.index() + 1) <=> (__w_index + 1);
+    }, __w);
+    return __ret;
+}
+
+constexpr strong_ordering
+operator<=>(monostate, monostate) noexcept {
+    return strong_ordering::equal;
+}
+#else
+constexpr bool operator!=(monostate, monostate) noexcept {
+    return false;
+}
+constexpr bool operator<(monostate, monostate) noexcept {
+    return false;
+}
+constexpr bool operator>(monostate, monostate) noexcept {
+    return false;
+}
+constexpr bool operator<=(monostate, monostate) noexcept {
+    return true;
+}
+constexpr bool operator>=(monostate, monostate) noexcept {
+    return true;
+}
+#endif
+
+template<typename _Visitor, typename... _Variants>
+constexpr decltype(auto)
+visit(_Visitor&& __visitor, _Variants&&... __variants) {
+    if ((__variants.valueless_by_exception() || ...)) {
+        __throw_bad_variant_access("std::visit: variant is valueless");
+    }
+
+    using _Result_type = std::invoke_result_t<_Visitor,
+          decltype(__detail::__variant::__unbox(
+                       std::get<0>(std::declval<_Variants>())))...>;
+
+    using _Tag = __detail::__variant::__deduce_visit_result<_Result_type>;
+
+    return std::__do_visit<_Tag>(std::forward<_Visitor>(__visitor),
+                                 std::forward<_Variants>(__variants)...);
+}
+
+#if __cplusplus > 201703L
+template<typename _Res, typename _Visitor, typename... _Variants>
+constexpr _Res
+visit(_Visitor&& __visitor, _Variants&&... __variants) {
+    if ((__variants.valueless_by_exception() || ...)) {
+        __throw_bad_variant_access("std::visit<R>: variant is valueless");
+    }
+
+    return std::__do_visit<_Res>(std::forward<_Visitor>(__visitor),
+                                 std::forward<_Variants>(__variants)...);
+}
+#endif
+
+template<bool, typename... _Types>
+struct __variant_hash_call_base_impl {
+    size_t
+    operator()(const variant<_Types...>& __t) const
+    noexcept((is_nothrow_invocable_v<hash<decay_t<_Types>>, _Types> && ...))
+    {
+        if constexpr (__detail::__variant::__all_empty_alts<_Types...>) {
+            return std::hash<size_t>{}(__t.index());
+        }
+
+        size_t __ret;
+        __detail::__variant::__raw_visit(
+        [&__t, &__ret](auto&& __t_mem) mutable {
+            using _Type = __remove_cvref_t<decltype(__t_mem)>;
+            if constexpr (!is_same_v<_Type,
+                          __detail::__variant::__variant_cookie>)
+                __ret = std::hash<size_t>{}(__t.index())
+            + std::hash<_Type>{}(__t_mem);
+            else
+                __ret = std::hash<size_t>{}(__t.index());
+        }, __t);
+        return __ret;
+    }
+};
+
+template<typename... _Types>
+struct __variant_hash_call_base_impl<false, _Types...> {};
+
+template<typename... _Types>
+using __variant_hash_call_base =
+__variant_hash_call_base_impl<(__poison_hash<remove_const_t<_Types>>::
+                               __enable_hash_call &&...), _Types...>;
+
+template<typename... _Types>
+struct hash<variant<_Types...>>
+: private __detail::__variant::_Variant_hash_base<
+    variant<_Types...>, std::index_sequence_for<_Types...>>,
+public __variant_hash_call_base<_Types...> {
+    using result_type [[__deprecated__]] = size_t;
+    using argument_type [[__deprecated__]] = variant<_Types...>;
+};
+
+template<>
+struct hash<monostate> {
+    using result_type [[__deprecated__]] = size_t;
+    using argument_type [[__deprecated__]] = monostate;
+
+    size_t
+    operator()(const monostate&) const noexcept
+    {
+        constexpr size_t __magic_monostate_hash = -7777;
+        return __magic_monostate_hash;
+    }
+};
+
+template<typename... _Types>
+struct __is_fast_hash<hash<variant<_Types...>>>
+: bool_constant<(__is_fast_hash<_Types>::value && ...)> {
+};
+
+_GLIBCXX_END_NAMESPACE_VERSION
+} // namespace std
+
+#endif // C++17
+
+#endif // _GLIBCXX_VARIANT_OPS
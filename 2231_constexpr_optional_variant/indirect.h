@@ -0,0 +1,433 @@
+#ifndef _GLIBCXX_INDIRECT
+#define _GLIBCXX_INDIRECT 1
+
+#if __cplusplus > 201703L
+
+#include <compare>
+#include <memory_resource>
+#include <new>
+#include "fixed_variant.h"
+
+namespace std _GLIBCXX_VISIBILITY(default)
+{
+_GLIBCXX_BEGIN_NAMESPACE_VERSION
+
+namespace __detail
+{
+namespace __indirect
+{
+// Size-class pool for indirect<T> blocks that use no memory_resource.
+//
+// Blocks are rounded up to one of _S_classes sizes, the powers of two from
+// 16 to 4096 bytes and the midpoints between them, so under a third of a
+// block goes unused. Freed blocks are kept on a per-thread free list of
+// their class, up to _S_cache_limit of them, so that a variant which
+// repeatedly creates and destroys a boxed alternative never reaches
+// operator new in the steady state. A block may be freed on a thread other
+// than the one that allocated it; it simply joins that thread's list.
+// Larger blocks, the lists of exiting threads, and blocks freed after the
+// thread's list is gone (say by another thread_local's destructor) go
+// straight back to operator delete.
+inline constexpr size_t _S_min_size = 16;
+inline constexpr size_t _S_classes = 17; // 16, 24, 32, 48, ... 4096 bytes
+inline constexpr size_t _S_cache_limit = 64;
+
+constexpr size_t
+__class_size(size_t __c) noexcept
+{
+    return (__c % 2 ? _S_min_size * 3 / 2 : _S_min_size) << (__c / 2);
+}
+
+constexpr size_t
+__size_class(size_t __n) noexcept
+{
+    size_t __c = 0;
+    while (__class_size(__c) < __n) {
+        ++__c;
+    }
+    return __c;
+}
+
+struct _Free_block {
+    _Free_block* _M_next;
+};
+
+// Set when this thread's _Thread_cache is destroyed. A bool has no
+// destructor, so it can still be read after the cache is gone.
+inline thread_local bool __cache_destroyed = false;
+
+struct _Thread_cache {
+    _Free_block* _M_head[_S_classes] = { };
+    unsigned _M_count[_S_classes] = { };
+
+    ~_Thread_cache()
+    {
+        __cache_destroyed = true;
+        for (size_t __c = 0; __c < _S_classes; ++__c) {
+            while (_Free_block* __b = _M_head[__c]) {
+                _M_head[__c] = __b->_M_next;
+                ::operator delete(__b, __class_size(__c));
+            }
+        }
+    }
+};
+
+inline _Thread_cache&
+__thread_cache() noexcept
+{
+    static thread_local _Thread_cache __cache;
+    return __cache;
+}
+
+inline void*
+__pool_allocate(size_t __n)
+{
+    const size_t __c = __size_class(__n);
+    if (__c >= _S_classes) {
+        return ::operator new(__n);
+    }
+    if (!__cache_destroyed) {
+        _Thread_cache& __cache = __thread_cache();
+        if (_Free_block* __b = __cache._M_head[__c]) {
+            __cache._M_head[__c] = __b->_M_next;
+            --__cache._M_count[__c];
+            return __b;
+        }
+    }
+    return ::operator new(__class_size(__c));
+}
+
+inline void
+__pool_deallocate(void* __p, size_t __n) noexcept
+{
+    const size_t __c = __size_class(__n);
+    if (__c >= _S_classes) {
+        ::operator delete(__p, __n);
+        return;
+    }
+    if (__cache_destroyed) {
+        ::operator delete(__p, __class_size(__c));
+        return;
+    }
+    _Thread_cache& __cache = __thread_cache();
+    if (__cache._M_count[__c] == _S_cache_limit) {
+        ::operator delete(__p, __class_size(__c));
+        return;
+    }
+    __cache._M_head[__c] = ::new (__p) _Free_block{__cache._M_head[__c]};
+    ++__cache._M_count[__c];
+}
+
+} // namespace __indirect
+} // namespace __detail
+
+/**
+  * @brief Owns a _Tp allocated out of line, with value semantics.
+  *
+  * Meant as a variant alternative for types that are large and rare:
+  * variant<_Small, indirect<_Huge>> is only as big as _Small and a
+  * pointer. std::visit sees the alternative as _Tp& directly. Copies are
+  * deep, moves steal the pointer and leave the source valueless.
+  *
+  * A valueless indirect compares equal to another valueless one and less
+  * than any other. It must not be dereferenced, nor visited inside a
+  * variant: std::visit has no _Tp to pass for it.
+  *
+  * By default the object is allocated from a size-class pool with
+  * per-thread free lists. Constructing with allocator_arg and a
+  * pmr::memory_resource allocates from that resource instead, e.g. a
+  * per-request monotonic_buffer_resource; copies use the resource of their
+  * source. The resource is kept in a header in front of the object, so
+  * sizeof(indirect<_Tp>) is always sizeof(void*).
+  */
+template<typename _Tp>
+class indirect
+{
+    static_assert(is_object_v<_Tp> && !is_array_v<_Tp>);
+    static_assert(!is_same_v<remove_cv_t<_Tp>, in_place_t>);
+
+    using _Resource = pmr::memory_resource;
+
+    // Block layout: a _Resource* header, then the object at _S_offset.
+    static constexpr size_t _S_align =
+        alignof(_Tp) > alignof(_Resource*) ? alignof(_Tp) : alignof(_Resource*);
+    static constexpr size_t _S_offset =
+        (sizeof(_Resource*) + alignof(_Tp) - 1) & ~(alignof(_Tp) - 1);
+    static constexpr size_t _S_size = _S_offset + sizeof(_Tp);
+
+    _Tp* _M_ptr;
+
+    static void*
+    _S_allocate(_Resource* __r)
+    {
+        if (__r) {
+            return __r->allocate(_S_size, _S_align);
+        }
+        if constexpr (_S_align > __STDCPP_DEFAULT_NEW_ALIGNMENT__) {
+            return ::operator new(_S_size, align_val_t(_S_align));
+        } else {
+            return __detail::__indirect::__pool_allocate(_S_size);
+        }
+    }
+
+    static void
+    _S_deallocate(_Resource* __r, void* __p) noexcept
+    {
+        if (__r) {
+            __r->deallocate(__p, _S_size, _S_align);
+        } else if constexpr (_S_align > __STDCPP_DEFAULT_NEW_ALIGNMENT__) {
+            ::operator delete(__p, _S_size, align_val_t(_S_align));
+        } else {
+            __detail::__indirect::__pool_deallocate(__p, _S_size);
+        }
+    }
+
+    template<typename... _Args>
+    static _Tp*
+    _S_make(_Resource* __r, _Args&&... __args)
+    {
+        void* __block = _S_allocate(__r);
+        ::new (__block) _Resource*(__r);
+        __try {
+            return ::new (static_cast<char*>(__block) + _S_offset)
+                   _Tp(std::forward<_Args>(__args)...);
+        }
+        __catch (...) {
+            _S_deallocate(__r, __block);
+            __throw_exception_again;
+        }
+    }
+
+    static _Resource*
+    _S_resource(const _Tp* __p) noexcept
+    {
+        return *reinterpret_cast<_Resource* const*>(
+                   reinterpret_cast<const char*>(__p) - _S_offset);
+    }
+
+    void
+    _M_destroy() noexcept
+    {
+        if (_M_ptr) {
+            _Resource* __r = _S_resource(_M_ptr);
+            _M_ptr->~_Tp();
+            _S_deallocate(__r, reinterpret_cast<char*>(_M_ptr) - _S_offset);
+            _M_ptr = nullptr;
+        }
+    }
+
+public:
+    using value_type = _Tp;
+
+    indirect()
+    requires is_default_constructible_v<_Tp>
+        : _M_ptr(_S_make(nullptr))
+    { }
+
+    template<typename _Up = _Tp>
+    requires (!is_same_v<__remove_cvref_t<_Up>, indirect>
+              && !is_same_v<__remove_cvref_t<_Up>, in_place_t>
+              && is_constructible_v<_Tp, _Up>)
+    indirect(_Up&& __u)
+        : _M_ptr(_S_make(nullptr, std::forward<_Up>(__u)))
+    { }
+
+    template<typename... _Args>
+    requires is_constructible_v<_Tp, _Args...>
+    explicit
+    indirect(in_place_t, _Args&&... __args)
+        : _M_ptr(_S_make(nullptr, std::forward<_Args>(__args)...))
+    { }
+
+    template<typename... _Args>
+    requires is_constructible_v<_Tp, _Args...>
+    indirect(allocator_arg_t, pmr::memory_resource* __r, _Args&&... __args)
+        : _M_ptr(_S_make(__r, std::forward<_Args>(__args)...))
+    { }
+
+    indirect(const indirect& __other)
+        : _M_ptr(__other._M_ptr
+                 ? _S_make(_S_resource(__other._M_ptr), *__other._M_ptr)
+                 : nullptr)
+    { }
+
+    indirect(indirect&& __other) noexcept
+        : _M_ptr(std::__exchange(__other._M_ptr, nullptr))
+    { }
+
+    ~indirect()
+    {
+        _M_destroy();
+    }
+
+    indirect&
+    operator=(const indirect& __other)
+    {
+        if (this == std::__addressof(__other)) {
+            return *this;
+        }
+        if constexpr (is_copy_assignable_v<_Tp>) {
+            // Reuse our block rather than allocating a new one.
+            if (_M_ptr && __other._M_ptr) {
+                *_M_ptr = *__other._M_ptr;
+                return *this;
+            }
+        }
+        indirect(__other).swap(*this);
+        return *this;
+    }
+
+    indirect&
+    operator=(indirect&& __other) noexcept
+    {
+        if (this != std::__addressof(__other)) {
+            _M_destroy();
+            _M_ptr = std::__exchange(__other._M_ptr, nullptr);
+        }
+        return *this;
+    }
+
+    template<typename _Up = _Tp>
+    requires (!is_same_v<__remove_cvref_t<_Up>, indirect>
+              && is_constructible_v<_Tp, _Up>
+              && is_assignable_v<_Tp&, _Up>)
+    indirect&
+    operator=(_Up&& __u)
+    {
+        if (_M_ptr) {
+            *_M_ptr = std::forward<_Up>(__u);
+        } else {
+            _M_ptr = _S_make(nullptr, std::forward<_Up>(__u));
+        }
+        return *this;
+    }
+
+    void
+    swap(indirect& __other) noexcept
+    {
+        std::swap(_M_ptr, __other._M_ptr);
+    }
+
+    friend void
+    swap(indirect& __lhs, indirect& __rhs) noexcept
+    {
+        __lhs.swap(__rhs);
+    }
+
+    // Observers.
+    bool
+    valueless_after_move() const noexcept
+    {
+        return _M_ptr == nullptr;
+    }
+
+    // The resource the object was allocated from, or nullptr for the pool.
+    pmr::memory_resource*
+    get_resource() const noexcept
+    {
+        return _M_ptr ? _S_resource(_M_ptr) : nullptr;
+    }
+
+    const _Tp*
+    operator->() const noexcept
+    {
+        __glibcxx_assert(_M_ptr);
+        return _M_ptr;
+    }
+
+    _Tp*
+    operator->() noexcept
+    {
+        __glibcxx_assert(_M_ptr);
+        return _M_ptr;
+    }
+
+    const _Tp&
+    operator*() const& noexcept
+    {
+        __glibcxx_assert(_M_ptr);
+        return *_M_ptr;
+    }
+
+    _Tp&
+    operator*()& noexcept
+    {
+        __glibcxx_assert(_M_ptr);
+        return *_M_ptr;
+    }
+
+    const _Tp&&
+    operator*() const&& noexcept
+    {
+        __glibcxx_assert(_M_ptr);
+        return std::move(*_M_ptr);
+    }
+
+    _Tp&&
+    operator*()&& noexcept
+    {
+        __glibcxx_assert(_M_ptr);
+        return std::move(*_M_ptr);
+    }
+};
+
+// A valueless indirect only equals another, and orders before any value.
+template<typename _Tp>
+inline bool
+operator==(const indirect<_Tp>& __lhs, const indirect<_Tp>& __rhs)
+{
+    if (__lhs.valueless_after_move() || __rhs.valueless_after_move()) {
+        return __lhs.valueless_after_move() == __rhs.valueless_after_move();
+    }
+    return *__lhs == *__rhs;
+}
+
+template<typename _Tp>
+inline bool
+operator<(const indirect<_Tp>& __lhs, const indirect<_Tp>& __rhs)
+{
+    if (__lhs.valueless_after_move() || __rhs.valueless_after_move()) {
+        return !__rhs.valueless_after_move();
+    }
+    return *__lhs < *__rhs;
+}
+
+template<typename _Tp>
+requires three_way_comparable<_Tp>
+inline compare_three_way_result_t<_Tp>
+operator<=>(const indirect<_Tp>& __lhs, const indirect<_Tp>& __rhs)
+{
+    if (__lhs.valueless_after_move() || __rhs.valueless_after_move()) {
+        return !__lhs.valueless_after_move() <=> !__rhs.valueless_after_move();
+    }
+    return *__lhs <=> *__rhs;
+}
+
+// Hash.
+
+template<typename _Tp, typename _Up = remove_const_t<_Tp>,
+         bool = __poison_hash<_Up>::__enable_hash_call>
+struct __indirect_hash_call_base {
+    size_t
+    operator()(const indirect<_Tp>& __t) const
+    noexcept(noexcept(hash<_Up>{}(*__t)))
+    {
+        return __t.valueless_after_move() ? size_t(-1) : hash<_Up>{}(*__t);
+    }
+};
+
+template<typename _Tp, typename _Up>
+struct __indirect_hash_call_base<_Tp, _Up, false> {};
+
+template<typename _Tp>
+struct hash<indirect<_Tp>>
+: private __poison_hash<remove_const_t<_Tp>>,
+public __indirect_hash_call_base<_Tp> {
+};
+
+_GLIBCXX_END_NAMESPACE_VERSION
+} // namespace std
+
+#endif // C++20
+
+#endif // _GLIBCXX_INDIRECT
@@ -0,0 +1,391 @@
+#ifndef _GLIBCXX_INPLACE_ANY
+#define _GLIBCXX_INPLACE_ANY 1
+
+#if __cplusplus > 201703L
+
+#include <any>
+#include <cstddef>
+#include <cstring>
+#include <new>
+#include <typeinfo>
+#include <bits/move.h>
+
+namespace std _GLIBCXX_VISIBILITY(default)
+{
+_GLIBCXX_BEGIN_NAMESPACE_VERSION
+
+template<size_t _Size, size_t _Align = alignof(max_align_t)>
+class inplace_any;
+
+namespace __detail
+{
+namespace __inplace_any
+{
+// The operations of one stored type. A null pointer means the operation
+// is a memcpy of the whole buffer (copy and relocate) or nothing at all
+// (destroy), so trivially copyable types are copied and moved without an
+// indirect call.
+struct _Ops {
+    void (*_M_copy)(void* __dst, const void* __src);
+    // Move-constructs into __dst and destroys __src.
+    void (*_M_relocate)(void* __dst, void* __src) noexcept;
+    void (*_M_destroy)(void* __p) noexcept;
+#if __cpp_rtti
+    const type_info* _M_type;
+#endif
+};
+
+template<typename _Tp>
+struct _Manager {
+    static void
+    _S_copy(void* __dst, const void* __src)
+    {
+        ::new (__dst) _Tp(*static_cast<const _Tp*>(__src));
+    }
+
+    static void
+    _S_relocate(void* __dst, void* __src) noexcept
+    {
+        _Tp* __p = static_cast<_Tp*>(__src);
+        ::new (__dst) _Tp(std::move(*__p));
+        __p->~_Tp();
+    }
+
+    static void
+    _S_destroy(void* __p) noexcept
+    {
+        static_cast<_Tp*>(__p)->~_Tp();
+    }
+
+    static constexpr bool _S_memcpy = is_trivially_copyable_v<_Tp>;
+};
+
+// One table per type, so a type check is a comparison with its address.
+template<typename _Tp>
+inline constexpr _Ops __ops = {
+    _Manager<_Tp>::_S_memcpy ? nullptr : &_Manager<_Tp>::_S_copy,
+    _Manager<_Tp>::_S_memcpy ? nullptr : &_Manager<_Tp>::_S_relocate,
+    is_trivially_destructible_v<_Tp> ? nullptr : &_Manager<_Tp>::_S_destroy,
+#if __cpp_rtti
+    &typeid(_Tp),
+#endif
+};
+
+template<typename _Tp>
+inline constexpr bool __is_inplace_any = false;
+
+template<size_t _Size, size_t _Align>
+inline constexpr bool __is_inplace_any<inplace_any<_Size, _Align>> = true;
+} // namespace __inplace_any
+} // namespace __detail
+
+/**
+  * @brief A type-erased copyable value held in _Size inline bytes.
+  *
+  * Like std::any, but it never allocates. A type that does not fit in
+  * _Size bytes at alignment _Align, or whose move constructor may throw,
+  * is rejected at compile time.
+  *
+  * An inplace_any is a buffer and a pointer to a static table of
+  * operations for the stored type. any_cast checks the type by comparing
+  * that pointer with the address of the table for the requested type. The
+  * table is an inline variable, so this relies on the usual one-definition
+  * guarantees: a type stored by one shared library and cast in another
+  * that does not export the table compares unequal.
+  *
+  * Trivially copyable types are copied and moved by copying the whole
+  * buffer, without an indirect call; other types go through the table.
+  * Moving leaves the source empty.
+  */
+template<size_t _Size, size_t _Align>
+class inplace_any
+{
+    static_assert(_Size > 0);
+    static_assert(_Align > 0 && (_Align & (_Align - 1)) == 0,
+                  "inplace_any alignment must be a power of two");
+
+    using _Ops = __detail::__inplace_any::_Ops;
+
+    template<typename _Tp>
+    static constexpr const _Ops* _S_ops = &__detail::__inplace_any::__ops<_Tp>;
+
+    alignas(_Align) unsigned char _M_storage[_Size];
+    const _Ops* _M_ops = nullptr;
+
+    template<typename _Tp>
+    static constexpr bool
+    _S_check() noexcept
+    {
+        static_assert(sizeof(_Tp) <= _Size,
+                      "type is too large for this inplace_any");
+        static_assert(alignof(_Tp) <= _Align,
+                      "type is over-aligned for this inplace_any");
+        static_assert(is_nothrow_move_constructible_v<_Tp>,
+                      "inplace_any requires a non-throwing move constructor");
+        return true;
+    }
+
+    template<typename _Tp, typename... _Args>
+    _Tp&
+    _M_emplace(_Args&&... __args)
+    {
+        static_assert(_S_check<_Tp>());
+        _Tp* __p = ::new (_M_storage) _Tp(std::forward<_Args>(__args)...);
+        _M_ops = _S_ops<_Tp>;
+        return *__p;
+    }
+
+    // Relocates the value of __other, if any, into *this, which must be
+    // empty, and leaves __other empty.
+    void
+    _M_take(inplace_any& __other) noexcept
+    {
+        if (__other._M_ops) {
+            if (__other._M_ops->_M_relocate) {
+                __other._M_ops->_M_relocate(_M_storage, __other._M_storage);
+            } else {
+                std::memcpy(_M_storage, __other._M_storage, _Size);
+            }
+            _M_ops = std::__exchange(__other._M_ops, nullptr);
+        }
+    }
+
+    template<typename _Tp>
+    using _Decay_if_storable = enable_if_t<
+        !__detail::__inplace_any::__is_inplace_any<decay_t<_Tp>>
+        && !__is_in_place_type_v<decay_t<_Tp>>
+        && is_copy_constructible_v<decay_t<_Tp>>, decay_t<_Tp>>;
+
+public:
+    inplace_any() noexcept = default;
+
+    inplace_any(const inplace_any& __other)
+    {
+        if (__other._M_ops) {
+            if (__other._M_ops->_M_copy) {
+                __other._M_ops->_M_copy(_M_storage, __other._M_storage);
+            } else {
+                std::memcpy(_M_storage, __other._M_storage, _Size);
+            }
+            _M_ops = __other._M_ops;
+        }
+    }
+
+    inplace_any(inplace_any&& __other) noexcept
+    {
+        _M_take(__other);
+    }
+
+    template<typename _Tp, typename _Vp = _Decay_if_storable<_Tp>>
+    requires is_constructible_v<_Vp, _Tp>
+    inplace_any(_Tp&& __value)
+    {
+        _M_emplace<_Vp>(std::forward<_Tp>(__value));
+    }
+
+    template<typename _Tp, typename... _Args,
+             typename _Vp = _Decay_if_storable<_Tp>>
+    requires is_constructible_v<_Vp, _Args...>
+    explicit
+    inplace_any(in_place_type_t<_Tp>, _Args&&... __args)
+    {
+        _M_emplace<_Vp>(std::forward<_Args>(__args)...);
+    }
+
+    template<typename _Tp, typename _Up, typename... _Args,
+             typename _Vp = _Decay_if_storable<_Tp>>
+    requires is_constructible_v<_Vp, initializer_list<_Up>&, _Args...>
+    explicit
+    inplace_any(in_place_type_t<_Tp>, initializer_list<_Up> __il,
+                _Args&&... __args)
+    {
+        _M_emplace<_Vp>(__il, std::forward<_Args>(__args)...);
+    }
+
+    ~inplace_any()
+    {
+        reset();
+    }
+
+    inplace_any&
+    operator=(const inplace_any& __rhs)
+    {
+        *this = inplace_any(__rhs);
+        return *this;
+    }
+
+    inplace_any&
+    operator=(inplace_any&& __rhs) noexcept
+    {
+        if (this != std::__addressof(__rhs)) {
+            reset();
+            _M_take(__rhs);
+        }
+        return *this;
+    }
+
+    template<typename _Tp, typename _Vp = _Decay_if_storable<_Tp>>
+    requires is_constructible_v<_Vp, _Tp>
+    inplace_any&
+    operator=(_Tp&& __rhs)
+    {
+        *this = inplace_any(std::forward<_Tp>(__rhs));
+        return *this;
+    }
+
+    // Modifiers.
+
+    template<typename _Tp, typename... _Args,
+             typename _Vp = _Decay_if_storable<_Tp>>
+    requires is_constructible_v<_Vp, _Args...>
+    _Vp&
+    emplace(_Args&&... __args)
+    {
+        reset();
+        return _M_emplace<_Vp>(std::forward<_Args>(__args)...);
+    }
+
+    template<typename _Tp, typename _Up, typename... _Args,
+             typename _Vp = _Decay_if_storable<_Tp>>
+    requires is_constructible_v<_Vp, initializer_list<_Up>&, _Args...>
+    _Vp&
+    emplace(initializer_list<_Up> __il, _Args&&... __args)
+    {
+        reset();
+        return _M_emplace<_Vp>(__il, std::forward<_Args>(__args)...);
+    }
+
+    void
+    reset() noexcept
+    {
+        if (_M_ops) {
+            if (_M_ops->_M_destroy) {
+                _M_ops->_M_destroy(_M_storage);
+            }
+            _M_ops = nullptr;
+        }
+    }
+
+    void
+    swap(inplace_any& __rhs) noexcept
+    {
+        if (this == std::__addressof(__rhs)) {
+            return;
+        }
+        inplace_any __tmp(std::move(__rhs));
+        __rhs._M_take(*this);
+        _M_take(__tmp);
+    }
+
+    friend void
+    swap(inplace_any& __lhs, inplace_any& __rhs) noexcept
+    {
+        __lhs.swap(__rhs);
+    }
+
+    // Observers.
+
+    bool
+    has_value() const noexcept
+    {
+        return _M_ops != nullptr;
+    }
+
+#if __cpp_rtti
+    const type_info&
+    type() const noexcept
+    {
+        return _M_ops ? *_M_ops->_M_type : typeid(void);
+    }
+#endif
+
+    // True if the stored value is a _Tp: a single pointer comparison.
+    template<typename _Tp>
+    bool
+    holds() const noexcept
+    {
+        return _M_ops == _S_ops<remove_cv_t<_Tp>>;
+    }
+
+    static constexpr size_t
+    capacity() noexcept
+    {
+        return _Size;
+    }
+
+    template<typename _Tp, size_t _Sz, size_t _Al>
+    friend const _Tp*
+    any_cast(const inplace_any<_Sz, _Al>*) noexcept;
+
+    template<typename _Tp, size_t _Sz, size_t _Al>
+    friend _Tp*
+    any_cast(inplace_any<_Sz, _Al>*) noexcept;
+};
+
+template<typename _Tp, size_t _Size, size_t _Align>
+inline const _Tp*
+any_cast(const inplace_any<_Size, _Align>* __a) noexcept
+{
+    static_assert(!is_void_v<_Tp>);
+    if (__a && __a->template holds<_Tp>()) {
+        return std::launder(reinterpret_cast<const _Tp*>(__a->_M_storage));
+    }
+    return nullptr;
+}
+
+template<typename _Tp, size_t _Size, size_t _Align>
+inline _Tp*
+any_cast(inplace_any<_Size, _Align>* __a) noexcept
+{
+    static_assert(!is_void_v<_Tp>);
+    if (__a && __a->template holds<_Tp>()) {
+        return std::launder(reinterpret_cast<_Tp*>(__a->_M_storage));
+    }
+    return nullptr;
+}
+
+template<typename _Tp, size_t _Size, size_t _Align>
+inline _Tp
+any_cast(const inplace_any<_Size, _Align>& __a)
+{
+    using _Up = __remove_cvref_t<_Tp>;
+    static_assert(is_constructible_v<_Tp, const _Up&>,
+                  "template argument must be constructible from a const value");
+    if (auto __p = std::any_cast<_Up>(std::__addressof(__a))) {
+        return static_cast<_Tp>(*__p);
+    }
+    __throw_bad_any_cast();
+}
+
+template<typename _Tp, size_t _Size, size_t _Align>
+inline _Tp
+any_cast(inplace_any<_Size, _Align>& __a)
+{
+    using _Up = __remove_cvref_t<_Tp>;
+    static_assert(is_constructible_v<_Tp, _Up&>,
+                  "template argument must be constructible from an lvalue");
+    if (auto __p = std::any_cast<_Up>(std::__addressof(__a))) {
+        return static_cast<_Tp>(*__p);
+    }
+    __throw_bad_any_cast();
+}
+
+template<typename _Tp, size_t _Size, size_t _Align>
+inline _Tp
+any_cast(inplace_any<_Size, _Align>&& __a)
+{
+    using _Up = __remove_cvref_t<_Tp>;
+    static_assert(is_constructible_v<_Tp, _Up>,
+                  "template argument must be constructible from an rvalue");
+    if (auto __p = std::any_cast<_Up>(std::__addressof(__a))) {
+        return static_cast<_Tp>(std::move(*__p));
+    }
+    __throw_bad_any_cast();
+}
+
+_GLIBCXX_END_NAMESPACE_VERSION
+} // namespace std
+
+#endif // C++20
+
+#endif // _GLIBCXX_INPLACE_ANY
@@ -0,0 +1,582 @@
+#ifndef _GLIBCXX_INTERNED_VARIANT
+#define _GLIBCXX_INTERNED_VARIANT 1
+
+#if __cplusplus > 201703L
+
+#include <atomic>
+#include <bit>
+#include <cmath>
+#include <cstdint>
+#include <mutex>
+#include <new>
+#include <vector>
+#include <bits/range_access.h>
+#include "fixed_variant.h"
+
+namespace std _GLIBCXX_VISIBILITY(default)
+{
+_GLIBCXX_BEGIN_NAMESPACE_VERSION
+
+template<typename... _Types>
+class interned_variant;
+
+namespace __detail
+{
+namespace __intern
+{
+// Base of every interned_variant, to recognize handles, and classes
+// derived from them, among the alternatives.
+struct _Handle_base { };
+
+template<typename _Tp>
+concept __handle = is_base_of_v<_Handle_base, _Tp>;
+
+template<typename _Tp>
+inline constexpr bool __is_in_place_tag = false;
+
+template<typename _Tp>
+inline constexpr bool __is_in_place_tag<in_place_type_t<_Tp>> = true;
+
+template<size_t _Np>
+inline constexpr bool __is_in_place_tag<in_place_index_t<_Np>> = true;
+
+template<typename _Tp>
+concept __handle_range = requires(const _Tp& __r) {
+    std::begin(__r);
+    std::end(__r);
+    requires __handle<__remove_cvref_t<decltype(*std::begin(__r))>>;
+};
+
+// The 64-bit finalizer of MurmurHash3.
+constexpr uint64_t
+__mix(uint64_t __x) noexcept
+{
+    __x ^= __x >> 33;
+    __x *= 0xff51afd7ed558ccdULL;
+    __x ^= __x >> 33;
+    __x *= 0xc4ceb9fe1a85ec53ULL;
+    __x ^= __x >> 33;
+    return __x;
+}
+
+// Handles hash by id, which identifies their value, and ranges of handles
+// by the sequence of ids, so hashing never follows a handle.
+template<typename _Tp>
+size_t
+__hash(const _Tp& __t)
+{
+    if constexpr (__handle<_Tp>) {
+        return __mix(__t.id());
+    } else if constexpr (is_floating_point_v<_Tp>) {
+        // Consistent with __equal, which makes all NaNs of a type with
+        // padding one value.
+        return __t != __t ? 0 : std::hash<_Tp>{}(__t);
+    } else if constexpr (__handle_range<_Tp>) {
+        uint64_t __h = 0;
+        for (const auto& __e : __t) {
+            __h = __mix(__h + __e.id() + 1);
+        }
+        return __h;
+    } else {
+        return std::hash<_Tp>{}(__t);
+    }
+}
+
+// Interning may only merge values that are interchangeable, which == does
+// not ensure for floating point: it equates -0.0 with 0.0 and no NaN with
+// itself. float and double compare by representation. Wider types may have
+// padding (the x87 long double has six unused bytes), so they compare by
+// value, with the sign of zero, and all their NaNs are one value.
+template<typename _Tp>
+bool
+__equal(const _Tp& __x, const _Tp& __y)
+{
+    if constexpr (is_same_v<_Tp, float>) {
+        return std::bit_cast<uint32_t>(__x) == std::bit_cast<uint32_t>(__y);
+    } else if constexpr (is_same_v<_Tp, double>) {
+        return std::bit_cast<uint64_t>(__x) == std::bit_cast<uint64_t>(__y);
+    } else if constexpr (is_floating_point_v<_Tp>) {
+        if (__x != __x) {
+            return __y != __y;
+        }
+        return __x == __y && std::signbit(__x) == std::signbit(__y);
+    } else {
+        return __x == __y;
+    }
+}
+
+template<typename... _Types>
+bool
+__equal_variant(const variant<_Types...>& __v, const variant<_Types...>& __w)
+{
+    if (__v.index() != __w.index()) {
+        return false;
+    }
+    bool __eq = true;
+    __variant::__raw_idx_visit(
+    [&__eq, &__w](const auto& __alt, auto __i) {
+        if constexpr (__i != variant_npos) {
+            __eq = __equal(__alt, __variant::__get<__i>(__w));
+        }
+    }, __v);
+    return __eq;
+}
+
+// hash<variant> adds the index to the hash of the alternative, so with
+// identity hashes of integers equal values of different alternatives
+// collide, and consecutive values fill consecutive buckets. Mixing spreads
+// both over all 64 bits, which the table uses to pick a shard and a slot.
+template<typename... _Types>
+size_t
+__hash_variant(const variant<_Types...>& __v)
+{
+    size_t __h = 0;
+    __variant::__raw_idx_visit(
+    [&__h](const auto& __alt, auto __i) {
+        if constexpr (__i != variant_npos) {
+            __h = __mix(__hash(__alt) + __i * 0x9e3779b97f4a7c15ULL);
+        }
+    }, __v);
+    return __h;
+}
+} // namespace __intern
+} // namespace __detail
+
+/**
+  * @brief The canonical values of interned_variant<_Types...>.
+  *
+  * Each distinct value is stored once, under a 32-bit id. Values are found
+  * by hash in one of _S_shards open-addressing tables, each with its own
+  * mutex, so concurrent interning only contends on equal shards. Values
+  * live in chunks that never move, twice as large as the one before, so
+  * an id is resolved without a lock.
+  *
+  * Handles are trivially copyable and so cannot be counted. Values are
+  * reclaimed by collect(), which keeps those reachable from the handles it
+  * is given and frees the others, as a tracing collector would. Each id
+  * has a generation, advanced when its value is freed, which handles
+  * record so that a freed id can be reused without them aliasing the new
+  * value.
+  */
+template<typename... _Types>
+class intern_table
+{
+public:
+    using value_type = variant<_Types...>;
+    using size_type = uint32_t;
+
+private:
+    friend class interned_variant<_Types...>;
+
+    static constexpr size_t _S_shards = 64;
+    static constexpr size_t _S_shard_shift = 64 - 6;
+    static constexpr size_t _S_base = 1024;
+    static constexpr size_t _S_max_chunks = 23; // Over 2^32 ids.
+
+    struct _Entry {
+        alignas(value_type) unsigned char _M_storage[sizeof(value_type)];
+        size_t _M_hash;
+        uint32_t _M_generation;
+        bool _M_live;
+        bool _M_marked;
+
+        value_type&
+        _M_value() noexcept
+        {
+            return *std::launder(reinterpret_cast<value_type*>(_M_storage));
+        }
+    };
+
+    // A slot holds the high half of the hash and the id plus one, or 0.
+    struct alignas(64) _Shard {
+        mutex _M_mutex;
+        vector<uint64_t> _M_slots;
+        size_t _M_count = 0;
+        vector<uint32_t> _M_free;
+    };
+
+    atomic<_Entry*> _M_chunks[_S_max_chunks] = {};
+    mutex _M_chunk_mutex;
+    atomic<uint32_t> _M_next{0};
+    atomic<size_type> _M_size{0};
+    _Shard _M_shards[_S_shards];
+
+    // Chunk __c holds _S_base << __c entries, from id _S_base * (2^__c - 1).
+    static pair<size_t, size_t>
+    _S_locate(uint32_t __id) noexcept
+    {
+        const size_t __c = std::bit_width(__id / _S_base + 1) - 1;
+        return { __c, __id - _S_base * ((size_t(1) << __c) - 1) };
+    }
+
+    _Entry&
+    _M_entry(uint32_t __id) const noexcept
+    {
+        const auto [__c, __off] = _S_locate(__id);
+        return _M_chunks[__c].load(memory_order_acquire)[__off];
+    }
+
+    _Entry&
+    _M_reserve(uint32_t __id)
+    {
+        const auto [__c, __off] = _S_locate(__id);
+        _Entry* __p = _M_chunks[__c].load(memory_order_acquire);
+        if (!__p) {
+            lock_guard<mutex> __l(_M_chunk_mutex);
+            __p = _M_chunks[__c].load(memory_order_relaxed);
+            if (!__p) {
+                __p = new _Entry[_S_base << __c]();
+                _M_chunks[__c].store(__p, memory_order_release);
+            }
+        }
+        return __p[__off];
+    }
+
+    static void
+    _S_place(_Shard& __s, uint64_t __slot, size_t __hash) noexcept
+    {
+        const size_t __mask = __s._M_slots.size() - 1;
+        size_t __i = __hash & __mask;
+        while (__s._M_slots[__i]) {
+            __i = (__i + 1) & __mask;
+        }
+        __s._M_slots[__i] = __slot;
+    }
+
+    void
+    _M_grow(_Shard& __s)
+    {
+        vector<uint64_t> __old(std::max<size_t>(64, 2 * __s._M_slots.size()));
+        __old.swap(__s._M_slots);
+        for (uint64_t __slot : __old) {
+            if (__slot) {
+                _S_place(__s, __slot, _M_entry(uint32_t(__slot) - 1)._M_hash);
+            }
+        }
+    }
+
+    // An id, and the generation of that id when the handle was made.
+    struct _Key {
+        uint32_t _M_id;
+        uint32_t _M_generation;
+    };
+
+    _Key
+    _M_intern(value_type&& __v)
+    {
+        if (__v.valueless_by_exception()) {
+            __throw_bad_variant_access("interned_variant: valueless");
+        }
+        const size_t __h = __detail::__intern::__hash_variant(__v);
+        const uint64_t __tag = __h & ~uint64_t(0xffffffff);
+        _Shard& __s = _M_shards[__h >> _S_shard_shift];
+        lock_guard<mutex> __l(__s._M_mutex);
+        if (2 * (__s._M_count + 1) > __s._M_slots.size()) {
+            _M_grow(__s);
+        }
+        const size_t __mask = __s._M_slots.size() - 1;
+        size_t __i = __h & __mask;
+        for (; __s._M_slots[__i]; __i = (__i + 1) & __mask) {
+            const uint64_t __slot = __s._M_slots[__i];
+            if ((__slot & ~uint64_t(0xffffffff)) == __tag) {
+                const uint32_t __id = uint32_t(__slot) - 1;
+                _Entry& __e = _M_entry(__id);
+                if (__detail::__intern::__equal_variant(__e._M_value(),
+                                                        __v)) {
+                    return { __id, __e._M_generation };
+                }
+            }
+        }
+
+        uint32_t __id;
+        if (!__s._M_free.empty()) {
+            __id = __s._M_free.back();
+            __s._M_free.pop_back();
+        } else {
+            // Never moves _M_next past the last id, so that after the throw
+            // it still bounds the ids in use.
+            __id = _M_next.load(memory_order_relaxed);
+            do {
+                if (__id == uint32_t(-1)) {
+                    __throw_length_error("intern_table: out of ids");
+                }
+            } while (!_M_next.compare_exchange_weak(__id, __id + 1,
+                                                    memory_order_relaxed));
+        }
+        _Entry& __e = _M_reserve(__id);
+        ::new (__e._M_storage) value_type(std::move(__v));
+        __e._M_hash = __h;
+        __e._M_live = true;
+        __s._M_slots[__i] = __tag | (uint64_t(__id) + 1);
+        ++__s._M_count;
+        _M_size.fetch_add(1, memory_order_relaxed);
+        return { __id, __e._M_generation };
+    }
+
+    const value_type&
+    _M_value(_Key __k) const noexcept
+    {
+        _Entry& __e = _M_entry(__k._M_id);
+        __glibcxx_assert(__e._M_generation == __k._M_generation);
+        return __e._M_value();
+    }
+
+    bool
+    _M_expired(_Key __k) const noexcept
+    {
+        return _M_entry(__k._M_id)._M_generation != __k._M_generation;
+    }
+
+    // Marks the handles to this table held by __alt.
+    template<typename _Tp, typename _Mark>
+    static void
+    _S_mark_children(const _Tp& __alt, _Mark& __mark)
+    {
+        if constexpr (is_base_of_v<interned_variant<_Types...>, _Tp>) {
+            __mark(__alt._M_key);
+        } else if constexpr (__detail::__intern::__handle_range<_Tp>) {
+            for (const auto& __e : __alt) {
+                using _Elt = __remove_cvref_t<decltype(__e)>;
+                if constexpr (is_base_of_v<interned_variant<_Types...>, _Elt>) {
+                    __mark(__e._M_key);
+                }
+            }
+        }
+    }
+
+public:
+    // Interns value_type() as id 0, the value of a default-constructed
+    // handle, which collect() never frees.
+    intern_table()
+    {
+        if constexpr (is_default_constructible_v<value_type>) {
+            _M_intern(value_type());
+        }
+    }
+
+    intern_table(const intern_table&) = delete;
+    intern_table& operator=(const intern_table&) = delete;
+
+    ~intern_table()
+    {
+        const uint32_t __n = _M_next.load(memory_order_relaxed);
+        for (size_t __c = 0; __c < _S_max_chunks; ++__c) {
+            _Entry* __p = _M_chunks[__c].load(memory_order_relaxed);
+            if (!__p) {
+                continue;
+            }
+            const size_t __first = _S_base * ((size_t(1) << __c) - 1);
+            for (size_t __i = 0; __i < (_S_base << __c)
+                                 && __first + __i < __n; ++__i) {
+                if (__p[__i]._M_live) {
+                    __p[__i]._M_value().~value_type();
+                }
+            }
+            delete[] __p;
+        }
+    }
+
+    // The number of distinct values held.
+    size_type
+    size() const noexcept
+    {
+        return _M_size.load(memory_order_relaxed);
+    }
+
+    /**
+      * @brief Frees the values not reachable from __roots.
+      *
+      * A value is reachable if it is held by a handle in __roots, or by a
+      * handle held by a reachable value, either as an alternative or as an
+      * element of a range alternative such as vector<handle>. A freed id
+      * may be reused, under the next generation: handles to the freed
+      * value are then expired(), compare unequal to handles to the new
+      * value, and must not be dereferenced. Expired handles in __roots
+      * are ignored.
+      *
+      * No other thread may use the table, or dereference its handles,
+      * during a collection. Returns the number of values freed.
+      */
+    template<typename _Range>
+    size_type
+    collect(const _Range& __roots)
+    {
+        vector<uint32_t> __stack;
+        auto __mark = [this, &__stack](_Key __k) {
+            _Entry& __e = _M_entry(__k._M_id);
+            if (!__e._M_marked && __e._M_generation == __k._M_generation) {
+                __e._M_marked = true;
+                __stack.push_back(__k._M_id);
+            }
+        };
+        if constexpr (is_default_constructible_v<value_type>) {
+            __mark({ 0, 0 });
+        }
+        for (const auto& __r : __roots) {
+            __mark(__r._M_key);
+        }
+        while (!__stack.empty()) {
+            const uint32_t __id = __stack.back();
+            __stack.pop_back();
+            std::visit([&__mark](const auto& __alt) {
+                _S_mark_children(__alt, __mark);
+            }, _M_entry(__id)._M_value());
+        }
+
+        for (_Shard& __s : _M_shards) {
+            std::fill(__s._M_slots.begin(), __s._M_slots.end(), 0);
+            __s._M_count = 0;
+        }
+        size_type __freed = 0;
+        const uint32_t __n = _M_next.load(memory_order_relaxed);
+        for (uint32_t __id = 0; __id < __n; ++__id) {
+            const auto [__c, __off] = _S_locate(__id);
+            _Entry* __p = _M_chunks[__c].load(memory_order_relaxed);
+            if (!__p || !__p[__off]._M_live) {
+                continue;
+            }
+            _Entry& __e = __p[__off];
+            _Shard& __s = _M_shards[__e._M_hash >> _S_shard_shift];
+            if (__e._M_marked) {
+                __e._M_marked = false;
+                _S_place(__s, (__e._M_hash & ~uint64_t(0xffffffff))
+                              | (uint64_t(__id) + 1), __e._M_hash);
+                ++__s._M_count;
+            } else {
+                __e._M_value().~value_type();
+                __e._M_live = false;
+                ++__e._M_generation;
+                __s._M_free.push_back(__id);
+                ++__freed;
+            }
+        }
+        _M_size.fetch_sub(__freed, memory_order_relaxed);
+        return __freed;
+    }
+};
+
+/**
+  * @brief Handle to a hash-consed, immutable variant<_Types...>.
+  *
+  * Constructing an interned_variant stores its value in the intern_table
+  * for _Types..., unless an equal value is there already, and keeps its
+  * 32-bit id and the generation of that id. Equal values therefore have
+  * equal ids: comparison compares ids and copying copies them. The value
+  * is reached through the table, with operator* or visit.
+  *
+  * For recursive values, derive from the handle:
+  *
+  *   struct Value : interned_variant<int64_t, string, vector<Value>>
+  *   { using interned_variant::interned_variant; };
+  *
+  * Alternatives must be hashable with std::hash, other handles, or ranges
+  * of handles, which hash and compare by id. Values are merged only if
+  * they are interchangeable: floating-point alternatives compare by
+  * representation, so -0.0 and 0.0 get different ids and equal NaNs the
+  * same one. Other alternatives compare with ==, which must therefore only
+  * equate values that cannot be told apart.
+  */
+template<typename... _Types>
+class interned_variant : public __detail::__intern::_Handle_base
+{
+    friend class intern_table<_Types...>;
+
+    using _Key = typename intern_table<_Types...>::_Key;
+
+    _Key _M_key = { 0, 0 };
+
+    template<typename _Up>
+    static constexpr bool __not_self =
+        !is_base_of_v<interned_variant, __remove_cvref_t<_Up>>
+        && !__detail::__intern::__is_in_place_tag<__remove_cvref_t<_Up>>;
+
+public:
+    using value_type = variant<_Types...>;
+    using table_type = intern_table<_Types...>;
+
+    // The table shared by all handles of this type. It is never destroyed
+    // before its handles, since it is created by the first of them.
+    static table_type&
+    table()
+    {
+        static table_type __table;
+        return __table;
+    }
+
+    // Holds value_type(), which the table interns as id 0.
+    interned_variant() noexcept
+    requires is_default_constructible_v<value_type>
+    = default;
+
+    template<typename _Up>
+    requires __not_self<_Up> && is_constructible_v<value_type, _Up>
+    interned_variant(_Up&& __u)
+        : _M_key(table()._M_intern(value_type(std::forward<_Up>(__u))))
+    { }
+
+    template<size_t _Np, typename... _Args>
+    explicit
+    interned_variant(in_place_index_t<_Np> __i, _Args&&... __args)
+        : _M_key(table()._M_intern(value_type(__i,
+                                             std::forward<_Args>(__args)...)))
+    { }
+
+    template<typename _Tp, typename... _Args>
+    explicit
+    interned_variant(in_place_type_t<_Tp> __t, _Args&&... __args)
+        : _M_key(table()._M_intern(value_type(__t,
+                                             std::forward<_Args>(__args)...)))
+    { }
+
+    // The canonical value, shared by all equal handles.
+    const value_type&
+    operator*() const noexcept
+    {
+        return table()._M_value(_M_key);
+    }
+
+    const value_type*
+    operator->() const noexcept
+    {
+        return std::__addressof(**this);
+    }
+
+    size_t index() const noexcept { return (**this).index(); }
+
+    uint32_t id() const noexcept { return _M_key._M_id; }
+
+    // Whether collect() has freed the value since this handle was made.
+    bool expired() const noexcept { return table()._M_expired(_M_key); }
+
+    template<typename _Visitor>
+    decltype(auto)
+    visit(_Visitor&& __vis) const
+    {
+        return std::visit(std::forward<_Visitor>(__vis), **this);
+    }
+
+    friend bool
+    operator==(const interned_variant& __x,
+               const interned_variant& __y) noexcept
+    {
+        // Id and generation, as one comparison.
+        return std::bit_cast<uint64_t>(__x._M_key)
+               == std::bit_cast<uint64_t>(__y._M_key);
+    }
+};
+
+template<typename... _Types>
+struct hash<interned_variant<_Types...>> {
+    size_t
+    operator()(const interned_variant<_Types...>& __v) const noexcept
+    {
+        return __detail::__intern::__mix(__v.id());
+    }
+};
+
+_GLIBCXX_END_NAMESPACE_VERSION
+} // namespace std
+
+#endif // C++20
+
+#endif // _GLIBCXX_INTERNED_VARIANT
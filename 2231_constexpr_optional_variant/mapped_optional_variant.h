@@ -0,0 +1,221 @@
+#ifndef _GLIBCXX_MAPPED_OPTIONAL_VARIANT
+#define _GLIBCXX_MAPPED_OPTIONAL_VARIANT 1
+
+#if __cplusplus > 201703L
+
+#include <cerrno>
+#include <string>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <bits/stl_algobase.h>
+#include "serialized_optional_variant.h"
+
+namespace std _GLIBCXX_VISIBILITY(default)
+{
+_GLIBCXX_BEGIN_NAMESPACE_VERSION
+
+// Read-only access to a file written by serialize, mapped into memory
+// instead of read and parsed.
+//
+// Opening a mapped_array maps the file, checks its header and does
+// nothing else: records are paged in by the kernel when first touched and
+// read in place through the views of serialized_optional_variant.h, so a
+// trivially copyable alternative is a const reference into the mapping.
+// Pages stay shared with the page cache, so several processes mapping the
+// same file share one copy of it.
+//
+// The file must not be truncated while it is mapped, which POSIX reports
+// as SIGBUS on access.
+//
+// This header requires POSIX mmap and madvise.
+
+/// Access pattern hints for mapped_array, passed to madvise.
+enum class map_advice {
+    normal,     // MADV_NORMAL: moderate read-ahead.
+    sequential, // MADV_SEQUENTIAL: aggressive read-ahead, early reclaim.
+    random,     // MADV_RANDOM: no read-ahead.
+    willneed,   // MADV_WILLNEED: start reading now.
+    dontneed,   // MADV_DONTNEED: drop the pages, re-read on next access.
+};
+
+namespace __detail
+{
+namespace __serial
+{
+constexpr int
+__madvise_flag(map_advice __a) noexcept
+{
+    switch (__a) {
+    case map_advice::sequential: return MADV_SEQUENTIAL;
+    case map_advice::random: return MADV_RANDOM;
+    case map_advice::willneed: return MADV_WILLNEED;
+    case map_advice::dontneed: return MADV_DONTNEED;
+    default: return MADV_NORMAL;
+    }
+}
+
+// A read-only private mapping of a whole file.
+class __mapping
+{
+    void* _M_addr = nullptr;
+    size_t _M_length = 0;
+
+public:
+    __mapping(const char* __path, map_advice __a)
+    {
+        const int __fd = ::open(__path, O_RDONLY | O_CLOEXEC);
+        if (__fd < 0) {
+            __throw_system_error(errno);
+        }
+        struct ::stat __st;
+        if (::fstat(__fd, &__st) != 0) {
+            const int __err = errno;
+            ::close(__fd);
+            __throw_system_error(__err);
+        }
+        _M_length = __st.st_size;
+        // An empty file has nothing to map and is rejected by deserialize.
+        if (_M_length != 0) {
+            _M_addr = ::mmap(nullptr, _M_length, PROT_READ, MAP_PRIVATE,
+                             __fd, 0);
+        }
+        const int __err = errno;
+        ::close(__fd);
+        if (_M_addr == MAP_FAILED) {
+            _M_addr = nullptr;
+            __throw_system_error(__err);
+        }
+        advise(__a, 0, _M_length);
+    }
+
+    __mapping(__mapping&& __m) noexcept
+        : _M_addr(std::__exchange(__m._M_addr, nullptr)),
+          _M_length(std::__exchange(__m._M_length, 0))
+    { }
+
+    __mapping&
+    operator=(__mapping&& __m) noexcept
+    {
+        std::swap(_M_addr, __m._M_addr);
+        std::swap(_M_length, __m._M_length);
+        return *this;
+    }
+
+    ~__mapping()
+    {
+        if (_M_addr) {
+            ::munmap(_M_addr, _M_length);
+        }
+    }
+
+    span<const byte>
+    bytes() const noexcept
+    {
+        return { static_cast<const byte*>(_M_addr), _M_length };
+    }
+
+    // Advises on the pages overlapping [__offset, __offset + __length).
+    // Advice is a hint, so failure is not reported.
+    void
+    advise(map_advice __a, size_t __offset, size_t __length) const noexcept
+    {
+        if (!_M_addr || __offset >= _M_length) {
+            return;
+        }
+        __length = std::min(__length, _M_length - __offset);
+        const size_t __page = ::sysconf(_SC_PAGESIZE);
+        const size_t __first = __offset & ~(__page - 1);
+        ::madvise(static_cast<byte*>(_M_addr) + __first,
+                  __offset + __length - __first, __madvise_flag(__a));
+    }
+};
+} // namespace __serial
+} // namespace __detail
+
+/**
+  * @brief The records of a file written by serialize, mapped read-only.
+  *
+  * Throws system_error if the file cannot be opened or mapped and
+  * invalid_argument if deserialize rejects its contents.
+  */
+template<typename _Tp>
+class mapped_array
+{
+    using _Traits = serial_traits<_Tp>;
+
+    __detail::__serial::__mapping _M_mapping;
+    serial_array<_Tp> _M_array;
+
+public:
+    using value_type = _Tp;
+    using view_type = typename _Traits::view_type;
+    using size_type = size_t;
+    using iterator = typename serial_array<_Tp>::iterator;
+
+    explicit
+    mapped_array(const char* __path, map_advice __a = map_advice::normal)
+        : _M_mapping(__path, __a),
+          _M_array(std::deserialize<_Tp>(_M_mapping.bytes()))
+    { }
+
+    explicit
+    mapped_array(const string& __path, map_advice __a = map_advice::normal)
+        : mapped_array(__path.c_str(), __a)
+    { }
+
+    // The mapping moves with the records; the source is left empty.
+    mapped_array(mapped_array&& __m) noexcept
+        : _M_mapping(std::move(__m._M_mapping)),
+          _M_array(std::__exchange(__m._M_array, {}))
+    { }
+
+    mapped_array&
+    operator=(mapped_array&& __m) noexcept
+    {
+        _M_mapping = std::move(__m._M_mapping);
+        _M_array = std::__exchange(__m._M_array, {});
+        return *this;
+    }
+
+    size_type size() const noexcept { return _M_array.size(); }
+
+    bool empty() const noexcept { return _M_array.empty(); }
+
+    view_type operator[](size_type __i) const { return _M_array[__i]; }
+
+    // Iterators refer to the serial_array in *this and are invalidated when
+    // it is moved from.
+    iterator begin() const noexcept { return _M_array.begin(); }
+
+    iterator end() const noexcept { return _M_array.end(); }
+
+    // The whole mapped file.
+    span<const byte> bytes() const noexcept { return _M_mapping.bytes(); }
+
+    // Advises on the whole file.
+    void
+    advise(map_advice __a) const noexcept
+    {
+        _M_mapping.advise(__a, 0, _M_mapping.bytes().size());
+    }
+
+    // Advises on the records [__first, __first + __count). Variable-size
+    // data of those records in the extent is not covered.
+    void
+    advise(map_advice __a, size_type __first, size_type __count) const noexcept
+    {
+        constexpr size_t __off = __detail::__serial::__records_offset<_Tp>;
+        __count = std::min(__count, size() - std::min(__first, size()));
+        _M_mapping.advise(__a, __off + __first * _Traits::size,
+                          __count * _Traits::size);
+    }
+};
+
+_GLIBCXX_END_NAMESPACE_VERSION
+} // namespace std
+
+#endif // C++20
+
+#endif // _GLIBCXX_MAPPED_OPTIONAL_VARIANT
@@ -0,0 +1,426 @@
+#ifndef _GLIBCXX_NANBOXED_VARIANT
+#define _GLIBCXX_NANBOXED_VARIANT 1
+
+#if __cplusplus > 201703L
+
+#include <bit>
+#include <cstdint>
+#include "fixed_variant.h"
+
+namespace std _GLIBCXX_VISIBILITY(default)
+{
+_GLIBCXX_BEGIN_NAMESPACE_VERSION
+
+namespace __detail
+{
+namespace __nanbox
+{
+// A word at or above _S_boxed is a negative quiet NaN, which no stored
+// double ever is because NaNs are canonicalized to _S_canonical_nan. Bits
+// 48-50 of a boxed word hold the index of its alternative and bits 0-47
+// hold the payload.
+inline constexpr uint64_t _S_boxed = 0xfff8'0000'0000'0000;
+inline constexpr uint64_t _S_canonical_nan = 0x7ff8'0000'0000'0000;
+inline constexpr unsigned _S_tag_shift = 48;
+inline constexpr uint64_t _S_payload_mask = (uint64_t(1) << _S_tag_shift) - 1;
+
+// How an alternative is encoded in the payload bits.
+template<typename _Tp>
+inline constexpr bool __is_payload_int =
+    is_integral_v<_Tp> && sizeof(_Tp) <= sizeof(uint32_t);
+
+template<typename _Tp>
+inline constexpr bool __is_payload_empty =
+    is_empty_v<_Tp> && is_trivial_v<_Tp>;
+
+template<typename _Tp>
+inline constexpr bool __is_boxable =
+    is_same_v<_Tp, double> || __is_payload_int<_Tp>
+    || __is_payload_empty<_Tp> || is_pointer_v<_Tp>;
+
+template<typename _Tp>
+constexpr uint64_t
+__encode(size_t __index, _Tp __t) noexcept
+{
+    if constexpr (is_same_v<_Tp, double>) {
+        return __t != __t ? _S_canonical_nan : std::bit_cast<uint64_t>(__t);
+    } else {
+        uint64_t __payload = 0;
+        if constexpr (is_same_v<_Tp, bool>) {
+            __payload = __t;
+        } else if constexpr (__is_payload_int<_Tp>) {
+            __payload = static_cast<make_unsigned_t<_Tp>>(__t);
+        } else if constexpr (is_pointer_v<_Tp>) {
+            __payload = reinterpret_cast<uintptr_t>(__t);
+            __glibcxx_assert((__payload & ~_S_payload_mask) == 0);
+        }
+        return _S_boxed | (uint64_t(__index) << _S_tag_shift) | __payload;
+    }
+}
+
+template<typename _Tp>
+constexpr _Tp
+__decode(uint64_t __w) noexcept
+{
+    if constexpr (is_same_v<_Tp, double>) {
+        return std::bit_cast<double>(__w);
+    } else if constexpr (is_same_v<_Tp, bool>) {
+        return __w & 1;
+    } else if constexpr (__is_payload_int<_Tp>) {
+        return static_cast<_Tp>(static_cast<make_unsigned_t<_Tp>>(__w));
+    } else if constexpr (is_pointer_v<_Tp>) {
+        return reinterpret_cast<_Tp>(static_cast<uintptr_t>(
+                   __w & _S_payload_mask));
+    } else {
+        return _Tp{};
+    }
+}
+
+// The result of get_if. Alternatives are not stored as objects, so this
+// holds a decoded copy and only behaves like a pointer to const.
+template<typename _Tp>
+class _Value_ptr {
+    _Tp _M_value;
+    bool _M_engaged;
+
+public:
+    constexpr _Value_ptr() noexcept : _M_value(), _M_engaged(false) { }
+
+    constexpr explicit
+    _Value_ptr(_Tp __t) noexcept : _M_value(__t), _M_engaged(true) { }
+
+    constexpr explicit operator bool() const noexcept { return _M_engaged; }
+
+    constexpr const _Tp& operator*() const noexcept { return _M_value; }
+
+    constexpr const _Tp* operator->() const noexcept
+    {
+        return std::__addressof(_M_value);
+    }
+
+    friend constexpr bool
+    operator==(const _Value_ptr& __p, nullptr_t) noexcept
+    {
+        return !__p._M_engaged;
+    }
+};
+
+} // namespace __nanbox
+} // namespace __detail
+
+/**
+  * @brief A variant of scalar alternatives packed into one 64-bit word.
+  *
+  * A double alternative is stored as itself; every other alternative is
+  * stored in the payload of a negative quiet NaN together with its index.
+  * The alternatives may be double, integers and bool of at most 32 bits,
+  * empty trivial types such as monostate, and pointers whose value fits in
+  * 48 bits (user-space pointers on x86-64 and AArch64), at most eight in
+  * all and each type at most once. NaN doubles are canonicalized on the
+  * way in, so their payload is not preserved.
+  *
+  * The converting constructor and assignment take exactly one of the
+  * alternative types, so nanboxed_variant(1.0f) does not compile.
+  *
+  * index(), holds_alternative and visit decode with a compare and a shift.
+  * Alternatives are not objects, so get returns by value, get_if returns a
+  * pointer-like wrapper around the decoded value, and visit passes values
+  * to the visitor.
+  */
+template<typename... _Types>
+class nanboxed_variant
+{
+    static_assert(sizeof...(_Types) > 0 && sizeof...(_Types) <= 8,
+                  "nanboxed_variant has room for at most eight alternatives");
+    static_assert((__detail::__nanbox::__is_boxable<_Types> && ...),
+                  "nanboxed_variant alternatives must be double, integers of"
+                  " at most 32 bits, empty trivial types or pointers");
+
+    template<typename _Tp>
+    static constexpr size_t _S_count = (is_same_v<_Tp, _Types> + ...);
+
+    template<typename _Tp>
+    static constexpr size_t _S_index_of =
+        __detail::__variant::__index_of_v<_Tp, _Types...>;
+
+    static constexpr size_t _S_double_index = _S_index_of<double>;
+
+    uint64_t _M_word;
+
+    template<size_t _Np>
+    using _Alt = typename __detail::__variant::_Nth_type<_Np, _Types...>::type;
+
+    template<typename _Res, size_t _Np, typename _Visitor>
+    constexpr _Res
+    _M_invoke(_Visitor& __vis) const
+    {
+        return std::__invoke_r<_Res>(__vis,
+            __detail::__nanbox::__decode<_Alt<_Np>>(_M_word));
+    }
+
+public:
+    static_assert(((_S_count<_Types> == 1) && ...),
+                  "nanboxed_variant alternatives must be distinct");
+
+    constexpr nanboxed_variant() noexcept
+        : _M_word(__detail::__nanbox::__encode(0, _Alt<0>()))
+    { }
+
+    template<typename _Tp>
+    requires (_S_count<_Tp> == 1)
+    constexpr
+    nanboxed_variant(_Tp __t) noexcept
+        : _M_word(__detail::__nanbox::__encode(_S_index_of<_Tp>, __t))
+    { }
+
+    template<typename _Tp, typename... _Args>
+    requires (_S_count<_Tp> == 1)
+    constexpr explicit
+    nanboxed_variant(in_place_type_t<_Tp>, _Args&&... __args) noexcept
+        : _M_word(__detail::__nanbox::__encode(
+                      _S_index_of<_Tp>, _Tp(std::forward<_Args>(__args)...)))
+    { }
+
+    template<size_t _Np, typename... _Args>
+    requires (_Np < sizeof...(_Types))
+    constexpr explicit
+    nanboxed_variant(in_place_index_t<_Np>, _Args&&... __args) noexcept
+        : _M_word(__detail::__nanbox::__encode(
+                      _Np, _Alt<_Np>(std::forward<_Args>(__args)...)))
+    { }
+
+    template<typename _Tp>
+    requires (_S_count<_Tp> == 1)
+    constexpr nanboxed_variant&
+    operator=(_Tp __t) noexcept
+    {
+        _M_word = __detail::__nanbox::__encode(_S_index_of<_Tp>, __t);
+        return *this;
+    }
+
+    template<typename _Tp, typename... _Args>
+    requires (_S_count<_Tp> == 1)
+    constexpr _Tp
+    emplace(_Args&&... __args) noexcept
+    {
+        _Tp __t(std::forward<_Args>(__args)...);
+        _M_word = __detail::__nanbox::__encode(_S_index_of<_Tp>, __t);
+        return __t;
+    }
+
+    template<size_t _Np, typename... _Args>
+    requires (_Np < sizeof...(_Types))
+    constexpr _Alt<_Np>
+    emplace(_Args&&... __args) noexcept
+    {
+        return emplace<_Alt<_Np>>(std::forward<_Args>(__args)...);
+    }
+
+    constexpr size_t
+    index() const noexcept
+    {
+        using namespace __detail::__nanbox;
+        if constexpr (_S_double_index == sizeof...(_Types)) {
+            return (_M_word >> _S_tag_shift) & 7;
+        } else {
+            return _M_word >= _S_boxed ? (_M_word >> _S_tag_shift) & 7
+                                       : _S_double_index;
+        }
+    }
+
+    constexpr bool
+    valueless_by_exception() const noexcept
+    {
+        return false;
+    }
+
+    // The encoded word, e.g. for hashing or storing in a value stack.
+    constexpr uint64_t
+    raw() const noexcept
+    {
+        return _M_word;
+    }
+
+    template<typename _Visitor>
+    constexpr decltype(auto)
+    visit(_Visitor&& __vis) const
+    {
+        using _Res = invoke_result_t<_Visitor&, _Alt<0>>;
+        static_assert((is_same_v<_Res, invoke_result_t<_Visitor&, _Types>>
+                       && ...),
+                      "nanboxed_variant::visit requires the visitor to have "
+                      "the same return type for all alternatives");
+        constexpr size_t __n = sizeof...(_Types);
+
+#define _GLIBCXX_VISIT_CASE(N) \
+        case N: \
+            if constexpr (N < __n) { \
+                return _M_invoke<_Res, N>(__vis); \
+            } else { \
+                __builtin_unreachable(); \
+            }
+
+        switch (index()) {
+        _GLIBCXX_VISIT_CASE(0)
+        _GLIBCXX_VISIT_CASE(1)
+        _GLIBCXX_VISIT_CASE(2)
+        _GLIBCXX_VISIT_CASE(3)
+        _GLIBCXX_VISIT_CASE(4)
+        _GLIBCXX_VISIT_CASE(5)
+        _GLIBCXX_VISIT_CASE(6)
+        _GLIBCXX_VISIT_CASE(7)
+        default:
+            __builtin_unreachable();
+        }
+#undef _GLIBCXX_VISIT_CASE
+    }
+
+    template<typename _Tp>
+    constexpr bool
+    _M_holds() const noexcept
+    {
+        using namespace __detail::__nanbox;
+        if constexpr (is_same_v<_Tp, double>) {
+            return _M_word < _S_boxed;
+        } else {
+            // One compare against the top 16 bits, which are the NaN
+            // prefix and the tag.
+            return (_M_word >> _S_tag_shift)
+                   == ((_S_boxed >> _S_tag_shift) | _S_index_of<_Tp>);
+        }
+    }
+
+    template<size_t _Np>
+    constexpr _Alt<_Np>
+    _M_get() const noexcept
+    {
+        return __detail::__nanbox::__decode<_Alt<_Np>>(_M_word);
+    }
+
+    friend constexpr bool
+    operator==(const nanboxed_variant& __lhs,
+               const nanboxed_variant& __rhs) noexcept
+    {
+        if constexpr (_S_double_index != sizeof...(_Types)) {
+            // Doubles compare as doubles: 0.0 == -0.0 and NaN != NaN.
+            if (__lhs._M_word < __detail::__nanbox::_S_boxed
+                && __rhs._M_word < __detail::__nanbox::_S_boxed) {
+                return __lhs._M_get<_S_double_index>()
+                       == __rhs._M_get<_S_double_index>();
+            }
+        }
+        return __lhs._M_word == __rhs._M_word;
+    }
+};
+
+template<typename _Tp, typename... _Types>
+constexpr bool
+holds_alternative(const nanboxed_variant<_Types...>& __v) noexcept
+{
+    static_assert((is_same_v<_Tp, _Types> || ...),
+                  "T must occur exactly once in alternatives");
+    return __v.template _M_holds<_Tp>();
+}
+
+template<size_t _Np, typename... _Types>
+constexpr typename __detail::__variant::_Nth_type<_Np, _Types...>::type
+get(const nanboxed_variant<_Types...>& __v)
+{
+    static_assert(_Np < sizeof...(_Types),
+                  "The index must be in [0, number of alternatives)");
+    if (__v.index() != _Np) {
+        __throw_bad_variant_access(false);
+    }
+    return __v.template _M_get<_Np>();
+}
+
+template<typename _Tp, typename... _Types>
+constexpr _Tp
+get(const nanboxed_variant<_Types...>& __v)
+{
+    static_assert((is_same_v<_Tp, _Types> || ...),
+                  "T must occur exactly once in alternatives");
+    return std::get<__detail::__variant::__index_of_v<_Tp, _Types...>>(__v);
+}
+
+template<size_t _Np, typename... _Types>
+constexpr __detail::__nanbox::_Value_ptr<
+    typename __detail::__variant::_Nth_type<_Np, _Types...>::type>
+get_if(const nanboxed_variant<_Types...>* __ptr) noexcept
+{
+    static_assert(_Np < sizeof...(_Types),
+                  "The index must be in [0, number of alternatives)");
+    if (__ptr && __ptr->index() == _Np) {
+        return __detail::__nanbox::_Value_ptr(
+                   __ptr->template _M_get<_Np>());
+    }
+    return { };
+}
+
+template<typename _Tp, typename... _Types>
+constexpr __detail::__nanbox::_Value_ptr<_Tp>
+get_if(const nanboxed_variant<_Types...>* __ptr) noexcept
+{
+    static_assert((is_same_v<_Tp, _Types> || ...),
+                  "T must occur exactly once in alternatives");
+    return std::get_if<__detail::__variant::__index_of_v<_Tp, _Types...>>(
+               __ptr);
+}
+
+// The alternatives are passed by value, so the value category of __v does
+// not matter; these overloads only take precedence over std::visit for
+// variant.
+template<typename _Visitor, typename... _Types>
+constexpr decltype(auto)
+visit(_Visitor&& __visitor, const nanboxed_variant<_Types...>& __v)
+{
+    return __v.visit(std::forward<_Visitor>(__visitor));
+}
+
+template<typename _Visitor, typename... _Types>
+constexpr decltype(auto)
+visit(_Visitor&& __visitor, nanboxed_variant<_Types...>& __v)
+{
+    return __v.visit(std::forward<_Visitor>(__visitor));
+}
+
+template<typename _Visitor, typename... _Types>
+constexpr decltype(auto)
+visit(_Visitor&& __visitor, nanboxed_variant<_Types...>&& __v)
+{
+    return __v.visit(std::forward<_Visitor>(__visitor));
+}
+
+template<typename... _Types>
+struct variant_size<nanboxed_variant<_Types...>>
+    : std::integral_constant<size_t, sizeof...(_Types)> {};
+
+template<size_t _Np, typename... _Types>
+struct variant_alternative<_Np, nanboxed_variant<_Types...>> {
+    static_assert(_Np < sizeof...(_Types),
+                  "The index must be in [0, number of alternatives)");
+
+    using type = typename __detail::__variant::_Nth_type<_Np, _Types...>::type;
+};
+
+template<typename... _Types>
+struct hash<nanboxed_variant<_Types...>> {
+    size_t
+    operator()(const nanboxed_variant<_Types...>& __v) const noexcept
+    {
+        // Consistent with ==, under which 0.0 and -0.0 are equal.
+        if constexpr ((is_same_v<_Types, double> || ...)) {
+            if (__v.template _M_holds<double>()) {
+                return std::hash<double>{}(std::get<double>(__v));
+            }
+        }
+        return std::hash<uint64_t>{}(__v.raw());
+    }
+};
+
+_GLIBCXX_END_NAMESPACE_VERSION
+} // namespace std
+
+#endif // C++20
+
+#endif // _GLIBCXX_NANBOXED_VARIANT
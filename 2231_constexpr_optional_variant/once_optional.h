@@ -0,0 +1,156 @@
+#ifndef _GLIBCXX_ONCE_OPTIONAL
+#define _GLIBCXX_ONCE_OPTIONAL 1
+
+#if __cplusplus > 201703L
+
+#include <atomic>
+#include "fixed_optional.h"
+
+namespace std _GLIBCXX_VISIBILITY(default)
+{
+_GLIBCXX_BEGIN_NAMESPACE_VERSION
+
+/**
+  * @brief Thread-safe lazily initialized optional.
+  *
+  * get_or_init(__f) constructs the contained value from the result of
+  * __f() exactly once, even when called concurrently. Once the value
+  * exists, get_or_init is a single acquire load and a branch. Threads that
+  * lose the race park in atomic::wait until the winner finishes. If __f
+  * throws, the optional stays disengaged and one of the waiters retries.
+  *
+  * The default constructor is constexpr, so a namespace-scope
+  * once_optional can be constinit and, when _Tp is trivially destructible,
+  * needs neither a static initializer nor an exit-time destructor.
+  */
+template<typename _Tp>
+class once_optional
+{
+    static_assert(!is_reference_v<_Tp>);
+
+    using _Stored_type = remove_const_t<_Tp>;
+    using _Storage = _Optional_storage<_Stored_type>;
+
+    // _S_busy_waiting means at least one thread is parked in wait().
+    enum _State : int {
+        _S_empty, _S_busy, _S_busy_waiting, _S_ready
+    };
+
+    atomic<int> _M_state{_S_empty};
+    _Storage _M_storage;
+
+    template<typename _Fn>
+    _Tp&
+    _M_init(_Fn& __f)
+    {
+        int __s = _M_state.load(memory_order_acquire);
+        for (;;) {
+            if (__s == _S_ready) {
+                return _M_storage._M_value;
+            }
+            if (__s == _S_empty) {
+                if (_M_state.compare_exchange_weak(__s, _S_busy,
+                                                   memory_order_acquire)) {
+                    break;
+                }
+                continue;
+            }
+            if (__s == _S_busy
+                && !_M_state.compare_exchange_weak(__s, _S_busy_waiting,
+                                                   memory_order_acquire)) {
+                continue;
+            }
+            _M_state.wait(_S_busy_waiting, memory_order_acquire);
+            __s = _M_state.load(memory_order_acquire);
+        }
+
+        // __f() is the initializer of the member, so a prvalue result is
+        // constructed in place, even if _Tp cannot be moved.
+        __try {
+            std::construct_at(std::__addressof(_M_storage),
+                              _Optional_func<_Fn&>{__f});
+        }
+        __catch (...) {
+            if (_M_state.exchange(_S_empty, memory_order_release)
+                == _S_busy_waiting) {
+                _M_state.notify_all();
+            }
+            __throw_exception_again;
+        }
+        if (_M_state.exchange(_S_ready, memory_order_release)
+            == _S_busy_waiting) {
+            _M_state.notify_all();
+        }
+        return _M_storage._M_value;
+    }
+
+public:
+    using value_type = _Tp;
+
+    constexpr once_optional() noexcept = default;
+
+    once_optional(const once_optional&) = delete;
+    once_optional& operator=(const once_optional&) = delete;
+
+    ~once_optional() requires is_trivially_destructible_v<_Tp> = default;
+
+    ~once_optional()
+    {
+        if (_M_state.load(memory_order_relaxed) == _S_ready) {
+            _M_storage._M_value.~_Stored_type();
+        }
+    }
+
+    template<typename _Fn>
+    _Tp&
+    get_or_init(_Fn&& __f)
+    {
+        if (_M_state.load(memory_order_acquire) == _S_ready) [[__likely__]] {
+            return _M_storage._M_value;
+        }
+        return _M_init(__f);
+    }
+
+    // Observers. These never wait for an initialization in progress.
+    bool
+    has_value() const noexcept
+    {
+        return _M_state.load(memory_order_acquire) == _S_ready;
+    }
+
+    explicit
+    operator bool() const noexcept
+    {
+        return has_value();
+    }
+
+    _Tp*
+    get() noexcept
+    {
+        return has_value() ? std::__addressof(_M_storage._M_value) : nullptr;
+    }
+
+    const _Tp*
+    get() const noexcept
+    {
+        return has_value() ? std::__addressof(_M_storage._M_value) : nullptr;
+    }
+
+    // Disengages the optional. Must not run concurrently with any other
+    // member function.
+    void
+    reset() noexcept
+    {
+        if (_M_state.load(memory_order_relaxed) == _S_ready) {
+            _M_storage._M_value.~_Stored_type();
+            _M_state.store(_S_empty, memory_order_relaxed);
+        }
+    }
+};
+
+_GLIBCXX_END_NAMESPACE_VERSION
+} // namespace std
+
+#endif // C++20
+
+#endif // _GLIBCXX_ONCE_OPTIONAL
@@ -0,0 +1,303 @@
+#ifndef _GLIBCXX_POLY_VARIANT
+#define _GLIBCXX_POLY_VARIANT 1
+
+#if __cplusplus > 201703L
+
+#include <cstdint>
+#include "fixed_variant.h"
+
+namespace std _GLIBCXX_VISIBILITY(default)
+{
+_GLIBCXX_BEGIN_NAMESPACE_VERSION
+
+template<typename _Base, typename... _Types>
+class poly_variant;
+
+namespace __detail
+{
+namespace __poly
+{
+template<typename _Tp>
+inline constexpr bool __is_poly_variant = false;
+
+template<typename _Base, typename... _Types>
+inline constexpr bool __is_poly_variant<poly_variant<_Base, _Types...>> = true;
+
+template<typename _Tp>
+inline constexpr bool __is_in_place_tag = false;
+
+template<typename _Tp>
+inline constexpr bool __is_in_place_tag<in_place_type_t<_Tp>> = true;
+
+template<size_t _Np>
+inline constexpr bool __is_in_place_tag<in_place_index_t<_Np>> = true;
+} // namespace __poly
+} // namespace __detail
+
+/**
+  * @brief A closed set of classes derived from _Base, stored inline.
+  *
+  * Replaces unique_ptr<_Base> for a hierarchy whose derived classes are all
+  * known: the object lives in a variant<_Types...>, so there is no heap
+  * allocation and a vector of them is contiguous.
+  *
+  * operator-> returns the _Base subobject by adding an offset to this.
+  * The offset is computed whenever the alternative changes and kept in
+  * the object, so access does not dispatch on the index. Calls through it
+  * are ordinary virtual calls.
+  *
+  * call(__f) invokes __f with the current alternative, which it selects
+  * by comparing the index with each alternative's in turn. __f is thus
+  * instantiated and inlined for each concrete type, so a member called by
+  * name, as in p.call([](auto& __s) { return __s.area(); }), is resolved
+  * statically when the alternatives are final, and inlined when visible.
+  * A pointer to a virtual member would not be: GCC calls it through the
+  * vtable even when the object's type is known.
+  */
+template<typename _Base, typename... _Types>
+class poly_variant
+{
+    static_assert(sizeof...(_Types) > 0);
+    static_assert((is_convertible_v<_Types*, _Base*> && ...),
+                  "every alternative must derive publicly and unambiguously "
+                  "from the base");
+    static_assert(!is_reference_v<_Base> && !is_const_v<_Base>);
+
+public:
+    using base_type = _Base;
+    using variant_type = variant<_Types...>;
+
+private:
+    variant_type _M_v;
+    // Offset from this to the _Base subobject of the current alternative.
+    // Relative to this, so the defaulted copy and move keep it valid.
+    uint32_t _M_offset = 0;
+
+    template<size_t _Np>
+    void
+    _M_cache() noexcept
+    {
+        const _Base* __b = std::__addressof(__detail::__variant::__get<_Np>(_M_v));
+        _M_offset = reinterpret_cast<const char*>(__b)
+                    - reinterpret_cast<const char*>(this);
+    }
+
+    void
+    _M_recache() noexcept
+    {
+        __detail::__variant::__raw_idx_visit(
+            [this](const auto&, auto __idx) {
+                if constexpr (__idx != variant_npos) {
+                    _M_cache<__idx>();
+                }
+            }, _M_v);
+    }
+
+    template<size_t _Np, typename _Self, typename _Fn>
+    static decltype(auto)
+    _S_call(_Self& __self, _Fn& __f)
+    {
+        if constexpr (_Np + 1 == sizeof...(_Types)) {
+            return __f(__detail::__variant::__get<_Np>(__self._M_v));
+        } else {
+            if (__self._M_v.index() == _Np) {
+                return __f(__detail::__variant::__get<_Np>(__self._M_v));
+            }
+            return _S_call<_Np + 1>(__self, __f);
+        }
+    }
+
+public:
+    poly_variant()
+    requires is_default_constructible_v<variant_type>
+    {
+        _M_cache<0>();
+    }
+
+    poly_variant(const poly_variant&) = default;
+    poly_variant(poly_variant&&) = default;
+    poly_variant& operator=(const poly_variant&) = default;
+    poly_variant& operator=(poly_variant&&) = default;
+
+    template<typename _Tp>
+    requires (!__detail::__poly::__is_poly_variant<__remove_cvref_t<_Tp>>
+              && !__detail::__poly::__is_in_place_tag<__remove_cvref_t<_Tp>>
+              && is_constructible_v<variant_type, _Tp>)
+    poly_variant(_Tp&& __t)
+    noexcept(is_nothrow_constructible_v<variant_type, _Tp>)
+        : _M_v(std::forward<_Tp>(__t))
+    {
+        _M_recache();
+    }
+
+    template<typename _Tp, typename... _Args>
+    requires is_constructible_v<variant_type, in_place_type_t<_Tp>, _Args...>
+    explicit
+    poly_variant(in_place_type_t<_Tp> __tag, _Args&&... __args)
+        : _M_v(__tag, std::forward<_Args>(__args)...)
+    {
+        _M_cache<__detail::__variant::__index_of_v<_Tp, _Types...>>();
+    }
+
+    template<size_t _Np, typename... _Args>
+    requires is_constructible_v<variant_type, in_place_index_t<_Np>, _Args...>
+    explicit
+    poly_variant(in_place_index_t<_Np> __tag, _Args&&... __args)
+        : _M_v(__tag, std::forward<_Args>(__args)...)
+    {
+        _M_cache<_Np>();
+    }
+
+    template<typename _Tp>
+    requires (!__detail::__poly::__is_poly_variant<__remove_cvref_t<_Tp>>
+              && is_assignable_v<variant_type&, _Tp>)
+    poly_variant&
+    operator=(_Tp&& __t)
+    {
+        _M_v = std::forward<_Tp>(__t);
+        _M_recache();
+        return *this;
+    }
+
+    template<typename _Tp, typename... _Args>
+    _Tp&
+    emplace(_Args&&... __args)
+    {
+        constexpr size_t _Np = __detail::__variant::__index_of_v<_Tp, _Types...>;
+        return emplace<_Np>(std::forward<_Args>(__args)...);
+    }
+
+    template<size_t _Np, typename... _Args>
+    variant_alternative_t<_Np, variant_type>&
+    emplace(_Args&&... __args)
+    {
+        auto& __r = _M_v.template emplace<_Np>(std::forward<_Args>(__args)...);
+        _M_cache<_Np>();
+        return __r;
+    }
+
+    // Observers.
+
+    size_t
+    index() const noexcept
+    {
+        return _M_v.index();
+    }
+
+    bool
+    valueless_by_exception() const noexcept
+    {
+        return _M_v.valueless_by_exception();
+    }
+
+    const variant_type&
+    as_variant() const noexcept
+    {
+        return _M_v;
+    }
+
+    _Base*
+    get() noexcept
+    {
+        __glibcxx_assert(!valueless_by_exception());
+        return reinterpret_cast<_Base*>(
+                   reinterpret_cast<char*>(this) + _M_offset);
+    }
+
+    const _Base*
+    get() const noexcept
+    {
+        __glibcxx_assert(!valueless_by_exception());
+        return reinterpret_cast<const _Base*>(
+                   reinterpret_cast<const char*>(this) + _M_offset);
+    }
+
+    _Base* operator->() noexcept { return get(); }
+
+    const _Base* operator->() const noexcept { return get(); }
+
+    _Base& operator*() noexcept { return *get(); }
+
+    const _Base& operator*() const noexcept { return *get(); }
+
+    // Invokes __f with the current alternative, through an if-chain on the
+    // index rather than a table of function pointers, so that each call is
+    // inlined with the alternative's exact type. The results must all have
+    // the same type.
+    template<typename _Fn>
+    decltype(auto)
+    call(_Fn&& __f)
+    {
+        __glibcxx_assert(!valueless_by_exception());
+        return _S_call<0>(*this, __f);
+    }
+
+    template<typename _Fn>
+    decltype(auto)
+    call(_Fn&& __f) const
+    {
+        __glibcxx_assert(!valueless_by_exception());
+        return _S_call<0>(*this, __f);
+    }
+
+    // Invokes __vis with the current alternative.
+    template<typename _Visitor>
+    decltype(auto)
+    visit(_Visitor&& __vis)
+    {
+        return std::visit(std::forward<_Visitor>(__vis), _M_v);
+    }
+
+    template<typename _Visitor>
+    decltype(auto)
+    visit(_Visitor&& __vis) const
+    {
+        return std::visit(std::forward<_Visitor>(__vis), _M_v);
+    }
+
+    void
+    swap(poly_variant& __other)
+    noexcept(is_nothrow_swappable_v<variant_type>)
+    {
+        _M_v.swap(__other._M_v);
+        _M_recache();
+        __other._M_recache();
+    }
+
+    friend void
+    swap(poly_variant& __lhs, poly_variant& __rhs)
+    noexcept(noexcept(__lhs.swap(__rhs)))
+    {
+        __lhs.swap(__rhs);
+    }
+};
+
+template<typename _Tp, typename _Base, typename... _Types>
+inline bool
+holds_alternative(const poly_variant<_Base, _Types...>& __p) noexcept
+{
+    return std::holds_alternative<_Tp>(__p.as_variant());
+}
+
+template<typename _Tp, typename _Base, typename... _Types>
+inline _Tp*
+get_if(poly_variant<_Base, _Types...>* __p) noexcept
+{
+    // The object is not const; only the variant accessor is.
+    return const_cast<_Tp*>(
+               std::get_if<_Tp>(__p ? &__p->as_variant() : nullptr));
+}
+
+template<typename _Tp, typename _Base, typename... _Types>
+inline const _Tp*
+get_if(const poly_variant<_Base, _Types...>* __p) noexcept
+{
+    return std::get_if<_Tp>(__p ? &__p->as_variant() : nullptr);
+}
+
+_GLIBCXX_END_NAMESPACE_VERSION
+} // namespace std
+
+#endif // C++20
+
+#endif // _GLIBCXX_POLY_VARIANT
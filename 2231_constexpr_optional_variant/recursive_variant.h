@@ -0,0 +1,260 @@
+#ifndef _GLIBCXX_RECURSIVE_VARIANT
+#define _GLIBCXX_RECURSIVE_VARIANT 1
+
+#if __cplusplus > 201703L
+
+#include <cstdint>
+#include <new>
+#include <vector>
+#include "fixed_variant.h"
+
+namespace std _GLIBCXX_VISIBILITY(default)
+{
+_GLIBCXX_BEGIN_NAMESPACE_VERSION
+
+/**
+  * @brief Link to a node of a recursive_variant, 32 bits wide.
+  *
+  * Alternatives of a recursive_variant refer to their children through
+  * recursive_ref members instead of owning pointers.
+  */
+struct recursive_ref {
+    uint32_t index;
+
+    friend constexpr bool
+    operator==(recursive_ref, recursive_ref) noexcept = default;
+};
+
+/**
+  * @brief A forest of variant<_Types...> nodes stored in a bump arena.
+  *
+  * Nodes are appended to chunks of _S_chunk_size nodes that never move, so
+  * node references stay valid and a recursive_ref is resolved with a shift
+  * and a mask. Building a tree costs one chunk allocation per
+  * _S_chunk_size nodes instead of one allocation per node. When every
+  * alternative is trivially destructible, clear() and destruction do not
+  * touch the nodes at all.
+  *
+  * A tree built bottom-up, as a parser does when it creates children before
+  * their parent, is laid out in post-order, so for_each_postorder() walks
+  * it depth-first with a linear scan of the arena.
+  */
+template<typename... _Types>
+class recursive_variant
+{
+public:
+    using value_type = variant<_Types...>;
+    using size_type = uint32_t;
+
+private:
+    static constexpr size_t _S_chunk_shift = 12;
+    static constexpr size_t _S_chunk_size = size_t(1) << _S_chunk_shift;
+    static constexpr bool _S_trivial_dtor =
+        is_trivially_destructible_v<value_type>;
+
+    vector<value_type*> _M_chunks;
+    size_type _M_size = 0;
+
+    value_type*
+    _M_slot(size_type __i) const noexcept
+    {
+        return _M_chunks[__i >> _S_chunk_shift]
+               + (__i & (_S_chunk_size - 1));
+    }
+
+    static value_type*
+    _S_allocate_chunk()
+    {
+        return static_cast<value_type*>(
+                   ::operator new(_S_chunk_size * sizeof(value_type),
+                                  align_val_t(alignof(value_type))));
+    }
+
+    void
+    _M_destroy_nodes() noexcept
+    {
+        if constexpr (!_S_trivial_dtor) {
+            for (size_type __i = 0; __i != _M_size; ++__i) {
+                _M_slot(__i)->~value_type();
+            }
+        }
+        _M_size = 0;
+    }
+
+    void
+    _M_release() noexcept
+    {
+        _M_destroy_nodes();
+        for (value_type* __c : _M_chunks) {
+            ::operator delete(__c, _S_chunk_size * sizeof(value_type),
+                              align_val_t(alignof(value_type)));
+        }
+        _M_chunks.clear();
+    }
+
+    // Out of line, so that appending to a chunk with room stays small
+    // enough to inline into the caller. This is also where the node count
+    // is checked: only a full last chunk can take _M_size past max_size().
+    // The chunk table is grown geometrically before the chunk is allocated,
+    // so push_back cannot throw and leak it.
+    __attribute__((__noinline__)) void
+    _M_grow()
+    {
+        if (_M_chunks.size() == max_size() / _S_chunk_size) {
+            __throw_length_error("recursive_variant: too many nodes");
+        }
+        if (_M_chunks.size() == _M_chunks.capacity()) {
+            _M_chunks.reserve(std::max<size_t>(2 * _M_chunks.capacity(), 1));
+        }
+        _M_chunks.push_back(_S_allocate_chunk());
+    }
+
+    template<typename... _Args>
+    recursive_ref
+    _M_append(_Args&&... __args)
+    {
+        if ((_M_size >> _S_chunk_shift) == _M_chunks.size())
+            [[__unlikely__]] {
+            _M_grow();
+        }
+        ::new (_M_slot(_M_size)) value_type(std::forward<_Args>(__args)...);
+        return recursive_ref{_M_size++};
+    }
+
+public:
+    recursive_variant() = default;
+
+    recursive_variant(recursive_variant&& __other) noexcept
+        : _M_chunks(std::move(__other._M_chunks)),
+          _M_size(std::__exchange(__other._M_size, 0))
+    { }
+
+    recursive_variant&
+    operator=(recursive_variant&& __other) noexcept
+    {
+        if (this != std::__addressof(__other)) {
+            _M_release();
+            _M_chunks = std::move(__other._M_chunks);
+            _M_size = std::__exchange(__other._M_size, 0);
+        }
+        return *this;
+    }
+
+    ~recursive_variant()
+    {
+        _M_release();
+    }
+
+    // Appends a node holding a _Tp constructed from __args.
+    template<typename _Tp, typename... _Args>
+    recursive_ref
+    emplace(_Args&&... __args)
+    {
+        return _M_append(in_place_type<_Tp>, std::forward<_Args>(__args)...);
+    }
+
+    template<size_t _Np, typename... _Args>
+    recursive_ref
+    emplace(_Args&&... __args)
+    {
+        return _M_append(in_place_index<_Np>, std::forward<_Args>(__args)...);
+    }
+
+    // Appends a node initialized from __u as variant<_Types...> would be.
+    template<typename _Up>
+    recursive_ref
+    push(_Up&& __u)
+    {
+        return _M_append(std::forward<_Up>(__u));
+    }
+
+    value_type&
+    operator[](recursive_ref __r) noexcept
+    {
+        __glibcxx_assert(__r.index < _M_size);
+        return *_M_slot(__r.index);
+    }
+
+    const value_type&
+    operator[](recursive_ref __r) const noexcept
+    {
+        __glibcxx_assert(__r.index < _M_size);
+        return *_M_slot(__r.index);
+    }
+
+    // Invokes __vis with the alternative held by node __r.
+    template<typename _Visitor>
+    decltype(auto)
+    visit(_Visitor&& __vis, recursive_ref __r)
+    {
+        return std::visit(std::forward<_Visitor>(__vis), (*this)[__r]);
+    }
+
+    template<typename _Visitor>
+    decltype(auto)
+    visit(_Visitor&& __vis, recursive_ref __r) const
+    {
+        return std::visit(std::forward<_Visitor>(__vis), (*this)[__r]);
+    }
+
+    // Invokes __vis(__r, __alt) for every node in arena order, which is
+    // post-order for trees whose children were created before their parents.
+    template<typename _Visitor>
+    void
+    for_each_postorder(_Visitor&& __vis)
+    {
+        for (size_type __c = 0; __c * _S_chunk_size < _M_size; ++__c) {
+            value_type* __chunk = _M_chunks[__c];
+            const size_type __base = __c * _S_chunk_size;
+            const size_type __n = std::min<size_type>(_S_chunk_size,
+                                                      _M_size - __base);
+            for (size_type __i = 0; __i != __n; ++__i) {
+                std::visit([&](auto& __alt) {
+                    __vis(recursive_ref{__base + __i}, __alt);
+                }, __chunk[__i]);
+            }
+        }
+    }
+
+    size_type
+    size() const noexcept
+    {
+        return _M_size;
+    }
+
+    // The whole chunks that 32-bit refs can address. Appending beyond this
+    // throws length_error.
+    static constexpr size_type
+    max_size() noexcept
+    {
+        return size_type(-1) & ~size_type(_S_chunk_size - 1);
+    }
+
+    bool
+    empty() const noexcept
+    {
+        return _M_size == 0;
+    }
+
+    // Removes every node but keeps the chunks for reuse. Constant time when
+    // all alternatives are trivially destructible.
+    void
+    clear() noexcept
+    {
+        _M_destroy_nodes();
+    }
+
+    // Removes every node and frees the chunks.
+    void
+    release() noexcept
+    {
+        _M_release();
+    }
+};
+
+_GLIBCXX_END_NAMESPACE_VERSION
+} // namespace std
+
+#endif // C++20
+
+#endif // _GLIBCXX_RECURSIVE_VARIANT
@@ -0,0 +1,322 @@
+#ifndef _GLIBCXX_RECYCLING_OPTIONAL
+#define _GLIBCXX_RECYCLING_OPTIONAL 1
+
+#if __cplusplus > 201703L
+
+#include "fixed_optional.h"
+
+namespace std _GLIBCXX_VISIBILITY(default)
+{
+_GLIBCXX_BEGIN_NAMESPACE_VERSION
+
+/**
+  * @brief Customization point for recycling_optional.
+  *
+  * reuse(__t, __args...) gives the dormant object __t the value that
+  * _Tp(__args...) would have, keeping whatever resources it can. The
+  * default: from no arguments, clear(); from an lvalue, clear() and copy
+  * assignment, which for containers reuses the existing capacity; from an
+  * rvalue, move assignment, which takes over the rvalue's resources rather
+  * than copying its elements into the old ones; from several arguments, a
+  * member assign(__args...) as containers have. Failing all of those, __t
+  * is assigned a temporary.
+  *
+  * Specialize this template for types whose resources are better reused
+  * some other way, e.g. by calling reserve() or reset(...) members.
+  */
+template<typename _Tp>
+struct recycle_traits {
+    static constexpr void
+    reuse(_Tp& __t)
+    {
+        if constexpr (requires { __t.clear(); }) {
+            __t.clear();
+        } else {
+            __t = _Tp();
+        }
+    }
+
+    template<typename _Up>
+    static constexpr void
+    reuse(_Tp& __t, _Up&& __u)
+    {
+        if constexpr (!is_lvalue_reference_v<_Up>
+                      && !is_const_v<remove_reference_t<_Up>>
+                      && is_assignable_v<_Tp&, _Up>) {
+            __t = std::forward<_Up>(__u);
+        } else if constexpr (is_assignable_v<_Tp&, const _Up&>) {
+            if constexpr (requires { __t.clear(); }) {
+                __t.clear();
+            }
+            __t = std::as_const(__u);
+        } else {
+            __t = _Tp(std::forward<_Up>(__u));
+        }
+    }
+
+    template<typename _Arg0, typename _Arg1, typename... _Args>
+    static constexpr void
+    reuse(_Tp& __t, _Arg0&& __arg0, _Arg1&& __arg1, _Args&&... __args)
+    {
+        if constexpr (requires { __t.assign(__arg0, __arg1, __args...); }) {
+            __t.assign(std::forward<_Arg0>(__arg0),
+                       std::forward<_Arg1>(__arg1),
+                       std::forward<_Args>(__args)...);
+        } else {
+            __t = _Tp(std::forward<_Arg0>(__arg0),
+                      std::forward<_Arg1>(__arg1),
+                      std::forward<_Args>(__args)...);
+        }
+    }
+};
+
+/**
+  * @brief Optional that keeps its payload's resources across reset().
+  *
+  * reset() only marks the contained object dormant; it stays alive, with
+  * whatever memory it owns. The next emplace or assignment re-engages it
+  * through recycle_traits<_Tp>::reuse instead of constructing a new object,
+  * so a scratch recycling_optional<vector<char>> that is reset and refilled
+  * once per request allocates only when it has to grow. shrink() destroys
+  * a dormant object, releasing its resources for real.
+  *
+  * Copies and moves transfer the engaged value only; a dormant object is
+  * never copied.
+  */
+template<typename _Tp>
+class recycling_optional
+{
+    static_assert(!is_reference_v<_Tp>);
+    static_assert(!is_const_v<_Tp>, "a const payload cannot be reused");
+
+    using _Storage = _Optional_storage<_Tp>;
+    using _Traits = recycle_traits<_Tp>;
+
+    enum _State : unsigned char {
+        _S_none, _S_dormant, _S_engaged
+    };
+
+    _Storage _M_storage;
+    _State _M_state = _S_none;
+
+    template<typename... _Args>
+    constexpr void
+    _M_engage(_Args&&... __args)
+    {
+        if (_M_state == _S_none) {
+            std::construct_at(std::__addressof(_M_storage._M_value),
+                              std::forward<_Args>(__args)...);
+        } else {
+            _Traits::reuse(_M_storage._M_value,
+                           std::forward<_Args>(__args)...);
+        }
+        _M_state = _S_engaged;
+    }
+
+    constexpr void
+    _M_destroy() noexcept
+    {
+        if (_M_state != _S_none) {
+            _M_state = _S_none;
+            _M_storage._M_value.~_Tp();
+        }
+    }
+
+public:
+    using value_type = _Tp;
+
+    constexpr recycling_optional() noexcept = default;
+
+    constexpr recycling_optional(nullopt_t) noexcept { }
+
+    template<typename... _Args,
+             enable_if_t<is_constructible_v<_Tp, _Args&&...>, bool> = false>
+    constexpr explicit
+    recycling_optional(in_place_t, _Args&&... __args)
+    {
+        _M_engage(std::forward<_Args>(__args)...);
+    }
+
+    constexpr
+    recycling_optional(const recycling_optional& __other)
+    requires is_copy_constructible_v<_Tp>
+    {
+        if (__other) {
+            _M_engage(*__other);
+        }
+    }
+
+    constexpr
+    recycling_optional(recycling_optional&& __other)
+    noexcept(is_nothrow_move_constructible_v<_Tp>)
+    requires is_move_constructible_v<_Tp>
+    {
+        if (__other) {
+            _M_engage(std::move(*__other));
+        }
+    }
+
+    constexpr recycling_optional&
+    operator=(const recycling_optional& __other)
+    requires is_copy_constructible_v<_Tp>
+    {
+        if (this != std::__addressof(__other)) {
+            if (__other) {
+                _M_engage(*__other);
+            } else {
+                reset();
+            }
+        }
+        return *this;
+    }
+
+    constexpr recycling_optional&
+    operator=(recycling_optional&& __other)
+    requires is_move_constructible_v<_Tp>
+    {
+        if (this != std::__addressof(__other)) {
+            if (__other) {
+                _M_engage(std::move(*__other));
+            } else {
+                reset();
+            }
+        }
+        return *this;
+    }
+
+    constexpr ~recycling_optional()
+    {
+        _M_destroy();
+    }
+
+    constexpr recycling_optional&
+    operator=(nullopt_t) noexcept
+    {
+        reset();
+        return *this;
+    }
+
+    template<typename _Up = _Tp>
+    constexpr
+    enable_if_t<!is_same_v<__remove_cvref_t<_Up>, recycling_optional>
+                && is_constructible_v<_Tp, _Up>,
+                recycling_optional&>
+    operator=(_Up&& __u)
+    {
+        _M_engage(std::forward<_Up>(__u));
+        return *this;
+    }
+
+    template<typename... _Args>
+    constexpr
+    enable_if_t<is_constructible_v<_Tp, _Args&&...>, _Tp&>
+    emplace(_Args&&... __args)
+    {
+        _M_engage(std::forward<_Args>(__args)...);
+        return _M_storage._M_value;
+    }
+
+    // Disengages without destroying the contained object.
+    constexpr void
+    reset() noexcept
+    {
+        if (_M_state == _S_engaged) {
+            _M_state = _S_dormant;
+        }
+    }
+
+    // Destroys a dormant object. An engaged value is left alone.
+    constexpr void
+    shrink() noexcept
+    {
+        if (_M_state == _S_dormant) {
+            _M_destroy();
+        }
+    }
+
+    // Whether a dormant object is being kept for reuse.
+    constexpr bool
+    is_dormant() const noexcept
+    {
+        return _M_state == _S_dormant;
+    }
+
+    // Observers.
+    constexpr explicit operator bool() const noexcept
+    {
+        return _M_state == _S_engaged;
+    }
+
+    constexpr bool has_value() const noexcept
+    {
+        return _M_state == _S_engaged;
+    }
+
+    constexpr const _Tp*
+    operator->() const
+    {
+        __glibcxx_assert(has_value());
+        return std::__addressof(_M_storage._M_value);
+    }
+
+    constexpr _Tp*
+    operator->()
+    {
+        __glibcxx_assert(has_value());
+        return std::__addressof(_M_storage._M_value);
+    }
+
+    constexpr const _Tp&
+    operator*() const&
+    {
+        __glibcxx_assert(has_value());
+        return _M_storage._M_value;
+    }
+
+    constexpr _Tp&
+    operator*()&
+    {
+        __glibcxx_assert(has_value());
+        return _M_storage._M_value;
+    }
+
+    constexpr _Tp&&
+    operator*()&&
+    {
+        __glibcxx_assert(has_value());
+        return std::move(_M_storage._M_value);
+    }
+
+    constexpr _Tp&
+    value()&
+    {
+        if (!has_value()) {
+            __throw_bad_optional_access();
+        }
+        return _M_storage._M_value;
+    }
+
+    constexpr const _Tp&
+    value() const&
+    {
+        if (!has_value()) {
+            __throw_bad_optional_access();
+        }
+        return _M_storage._M_value;
+    }
+
+    template<typename _Up>
+    constexpr _Tp
+    value_or(_Up&& __u) const&
+    {
+        return has_value() ? _M_storage._M_value
+               : static_cast<_Tp>(std::forward<_Up>(__u));
+    }
+};
+
+_GLIBCXX_END_NAMESPACE_VERSION
+} // namespace std
+
+#endif // C++20
+
+#endif // _GLIBCXX_RECYCLING_OPTIONAL
@@ -0,0 +1,758 @@
+#ifndef _GLIBCXX_SERIALIZED_OPTIONAL_VARIANT
+#define _GLIBCXX_SERIALIZED_OPTIONAL_VARIANT 1
+
+#if __cplusplus > 201703L
+
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <span>
+#include <string>
+#include <string_view>
+#include <bits/functexcept.h>
+#include <bits/stl_iterator_base_types.h>
+#include "fixed_optional.h"
+#include "fixed_variant.h"
+
+namespace std _GLIBCXX_VISIBILITY(default)
+{
+_GLIBCXX_BEGIN_NAMESPACE_VERSION
+
+// Binary serialization of arrays of optionals and variants, read back in
+// place.
+//
+// A buffer holds a serial_header, an array of fixed-size records and an
+// extent with the variable-size data the records refer to. A value of
+// type _Tp takes a slot of serial_traits<_Tp>::size bytes aligned to
+// serial_traits<_Tp>::alignment:
+//
+//   trivially copyable _Tp  the object representation of _Tp.
+//   optional<_Tp>           an engaged byte, then the slot of _Tp at the
+//                           next multiple of its alignment.
+//   variant<_Types...>      a 32-bit index, then the slot of the held
+//                           alternative at the next multiple of the
+//                           largest alternative alignment, padded to the
+//                           largest alternative slot.
+//   basic_string<_CharT>    the 64-bit offset and length of its
+//   basic_string_view       characters in the extent.
+//
+// Slots nest, so variant<optional<_Tp>, variant<...>> has a fixed layout
+// too. Padding is zeroed, so equal values encode to equal bytes.
+//
+// deserialize does not copy anything: it checks the header and returns a
+// serial_array whose elements are views into the buffer. A trivially
+// copyable _Tp is read as a const _Tp& into the buffer, optional<_Tp> as
+// optional_view<_Tp> and variant<_Types...> as variant_view<_Types...>.
+// Values keep the byte order of the writer, which the header records; a
+// buffer written in the other byte order is rejected rather than
+// converted.
+//
+// Other types are made serializable by specializing serial_traits with:
+//
+//   static constexpr size_t size, alignment;
+//   using view_type = ...;
+//   static void encode(const _Tp&, byte* __slot, serial_extent_writer&);
+//   static view_type decode(const byte* __slot, serial_extent);
+//
+// and, if encode appends to the extent, the number of bytes it appends:
+//
+//   static size_t extent_size(const _Tp&);
+
+template<typename _Tp>
+struct serial_traits;
+
+template<typename _Tp>
+class optional_view;
+
+template<typename... _Types>
+class variant_view;
+
+/// Layout version written by serialize and accepted by deserialize.
+inline constexpr uint16_t serial_version = 1;
+
+/// The first bytes of a serialized buffer.
+struct serial_header {
+    uint32_t magic;
+    uint16_t version;
+    uint8_t endian;     // 1 for little endian, 2 for big endian.
+    uint8_t align_log2; // Alignment of the records.
+    uint32_t record_size;
+    uint32_t reserved;
+    uint64_t count;
+    uint64_t extent_size;
+};
+
+/// The extent of a serialized buffer, as seen by decode.
+struct serial_extent {
+    const byte* data;
+    size_t size;
+
+    // Returns the __length bytes at __offset, which must lie inside the
+    // extent.
+    const byte*
+    at(uint64_t __offset, uint64_t __length) const
+    {
+        if (__offset > size || __length > size - __offset) {
+            __throw_out_of_range("serial_extent: reference out of bounds");
+        }
+        return data + __offset;
+    }
+};
+
+/// Appends variable-size data to the extent of a buffer being written.
+class serial_extent_writer {
+    byte* _M_data;
+    size_t _M_size = 0;
+
+public:
+    explicit
+    serial_extent_writer(byte* __data) noexcept
+        : _M_data(__data)
+    { }
+
+    // Copies __n bytes to the end of the extent and returns their offset.
+    uint64_t
+    append(const void* __p, size_t __n) noexcept
+    {
+        if (__n != 0) {
+            __builtin_memcpy(_M_data + _M_size, __p, __n);
+        }
+        return std::__exchange(_M_size, _M_size + __n);
+    }
+
+    size_t
+    size() const noexcept
+    {
+        return _M_size;
+    }
+};
+
+namespace __detail
+{
+namespace __serial
+{
+inline constexpr uint32_t __magic = 0x564f5846; // "FXOV" in little endian.
+
+constexpr uint8_t
+__native_endian() noexcept
+{
+    return std::endian::native == std::endian::little ? 1 : 2;
+}
+
+constexpr size_t
+__round_up(size_t __n, size_t __align) noexcept
+{
+    return (__n + __align - 1) & ~(__align - 1);
+}
+
+template<typename... _Sizes>
+constexpr size_t
+__max(_Sizes... __sizes) noexcept
+{
+    size_t __m = 0;
+    ((__m = __m < __sizes ? __sizes : __m), ...);
+    return __m;
+}
+
+template<typename _Tp>
+concept __has_extent = requires(const _Tp& __t) {
+    { serial_traits<_Tp>::extent_size(__t) } -> convertible_to<size_t>;
+};
+
+template<typename _Tp>
+size_t
+__extent_size(const _Tp& __t)
+{
+    if constexpr (__has_extent<_Tp>) {
+        return serial_traits<_Tp>::extent_size(__t);
+    } else {
+        return 0;
+    }
+}
+
+template<typename _Tp>
+inline constexpr bool __is_special = false;
+
+template<typename _Tp>
+inline constexpr bool __is_special<optional<_Tp>> = true;
+
+template<typename... _Types>
+inline constexpr bool __is_special<variant<_Types...>> = true;
+
+// Characters of a string stored in the extent.
+template<typename _CharT, typename _Traits>
+struct __chars {
+    static_assert(sizeof(_CharT) == 1,
+                  "extent data is not aligned, so only narrow characters"
+                  " can be serialized");
+
+    static constexpr size_t size = 2 * sizeof(uint64_t);
+    static constexpr size_t alignment = alignof(uint64_t);
+    using view_type = basic_string_view<_CharT, _Traits>;
+
+    static size_t
+    extent_size(view_type __s) noexcept
+    {
+        return __s.size();
+    }
+
+    static void
+    encode(view_type __s, byte* __p, serial_extent_writer& __w) noexcept
+    {
+        const uint64_t __ref[2] = { __w.append(__s.data(), __s.size()),
+                                    __s.size() };
+        __builtin_memcpy(__p, __ref, sizeof(__ref));
+    }
+
+    static view_type
+    decode(const byte* __p, serial_extent __e)
+    {
+        uint64_t __ref[2];
+        __builtin_memcpy(__ref, __p, sizeof(__ref));
+        return view_type(reinterpret_cast<const _CharT*>(
+                             __e.at(__ref[0], __ref[1])), __ref[1]);
+    }
+};
+
+// The slot of a _Tp at the start of __bytes, which must be large enough
+// and suitably aligned to hold one.
+template<typename _Tp>
+const byte*
+__checked_slot(span<const byte> __bytes)
+{
+    if (__bytes.size() < serial_traits<_Tp>::size) {
+        __throw_invalid_argument("serial view: slot out of bounds");
+    }
+    if (reinterpret_cast<uintptr_t>(__bytes.data())
+        % serial_traits<_Tp>::alignment) {
+        __throw_invalid_argument("serial view: slot misaligned");
+    }
+    return __bytes.data();
+}
+
+// Dispatches a visitor on the index of a variant_view through a table of
+// one function per alternative, the way std::visit uses _S_vtable.
+template<typename _Res, typename _Visitor, typename _View, typename _Seq>
+struct __vtable;
+
+template<typename _Res, typename _Visitor, typename _View, size_t... _Ind>
+struct __vtable<_Res, _Visitor, _View, index_sequence<_Ind...>> {
+    template<size_t _Np>
+    static _Res
+    _S_invoke(_Visitor&& __vis, const _View& __v)
+    {
+        return std::__invoke(std::forward<_Visitor>(__vis),
+                             __v.template _M_get<_Np>());
+    }
+
+    static constexpr _Res (*_S_table[])(_Visitor&&, const _View&)
+        = { &_S_invoke<_Ind>... };
+};
+
+} // namespace __serial
+} // namespace __detail
+
+/// Trivially copyable types are stored as their object representation.
+template<typename _Tp>
+requires (is_trivially_copyable_v<_Tp> && !__detail::__serial::__is_special<_Tp>)
+struct serial_traits<_Tp> {
+    static constexpr size_t size = sizeof(_Tp);
+    static constexpr size_t alignment = alignof(_Tp);
+    using view_type = const _Tp&;
+
+    static void
+    encode(const _Tp& __t, byte* __p, serial_extent_writer&) noexcept
+    {
+        __builtin_memcpy(__p, std::__addressof(__t), sizeof(_Tp));
+    }
+
+    // The slot is suitably aligned and holds the bytes of a _Tp, which
+    // being trivially copyable is implicitly created there.
+    static view_type
+    decode(const byte* __p, serial_extent) noexcept
+    {
+        return *std::launder(reinterpret_cast<const _Tp*>(__p));
+    }
+};
+
+template<typename _CharT, typename _Traits, typename _Alloc>
+struct serial_traits<basic_string<_CharT, _Traits, _Alloc>>
+    : __detail::__serial::__chars<_CharT, _Traits> { };
+
+template<typename _CharT, typename _Traits>
+struct serial_traits<basic_string_view<_CharT, _Traits>>
+    : __detail::__serial::__chars<_CharT, _Traits> { };
+
+template<typename _Tp>
+struct serial_traits<optional<_Tp>> {
+    using _Traits = serial_traits<remove_const_t<_Tp>>;
+
+    static constexpr size_t _S_offset = _Traits::alignment;
+    static constexpr size_t alignment = _Traits::alignment;
+    static constexpr size_t size =
+        __detail::__serial::__round_up(_S_offset + _Traits::size, alignment);
+    using view_type = optional_view<remove_const_t<_Tp>>;
+
+    static size_t
+    extent_size(const optional<_Tp>& __o)
+    requires __detail::__serial::__has_extent<remove_const_t<_Tp>>
+    {
+        return __o ? _Traits::extent_size(*__o) : 0;
+    }
+
+    static void
+    encode(const optional<_Tp>& __o, byte* __p, serial_extent_writer& __w)
+    {
+        __builtin_memset(__p, 0, size);
+        if (__o) {
+            __p[0] = byte{1};
+            _Traits::encode(*__o, __p + _S_offset, __w);
+        }
+    }
+
+    static view_type
+    decode(const byte* __p, serial_extent __e)
+    {
+        return view_type(__p, __e);
+    }
+};
+
+template<typename... _Types>
+struct serial_traits<variant<_Types...>> {
+    static constexpr size_t _S_payload_align =
+        __detail::__serial::__max(serial_traits<_Types>::alignment...);
+    static constexpr size_t _S_offset =
+        __detail::__serial::__round_up(sizeof(uint32_t), _S_payload_align);
+    static constexpr size_t alignment =
+        __detail::__serial::__max(alignof(uint32_t), _S_payload_align);
+    static constexpr size_t size = __detail::__serial::__round_up(
+        _S_offset + __detail::__serial::__max(serial_traits<_Types>::size...),
+        alignment);
+    using view_type = variant_view<_Types...>;
+
+    static size_t
+    extent_size(const variant<_Types...>& __v)
+    requires (__detail::__serial::__has_extent<_Types> || ...)
+    {
+        return std::visit([](const auto& __alt) {
+            return __detail::__serial::__extent_size(__alt);
+        }, __v);
+    }
+
+    static void
+    encode(const variant<_Types...>& __v, byte* __p,
+           serial_extent_writer& __w)
+    {
+        if (__v.valueless_by_exception()) {
+            __throw_bad_variant_access("serialize: variant is valueless");
+        }
+        __builtin_memset(__p, 0, size);
+        const uint32_t __index = __v.index();
+        __builtin_memcpy(__p, &__index, sizeof(__index));
+        __detail::__variant::__raw_idx_visit(
+        [__p, &__w](const auto& __alt, auto __i) {
+            if constexpr (__i != variant_npos) {
+                using _Alt = variant_alternative_t<__i, variant<_Types...>>;
+                serial_traits<_Alt>::encode(__alt, __p + _S_offset, __w);
+            }
+        }, __v);
+    }
+
+    static view_type
+    decode(const byte* __p, serial_extent __e)
+    {
+        return view_type(__p, __e);
+    }
+};
+
+/**
+  * @brief A serialized optional<_Tp>, read in place.
+  */
+template<typename _Tp>
+class optional_view
+{
+    using _Traits = serial_traits<_Tp>;
+
+    const byte* _M_p;
+    serial_extent _M_extent;
+    bool _M_engaged;
+
+public:
+    using value_type = _Tp;
+    using view_type = typename _Traits::view_type;
+
+    // __p is the slot of an optional<_Tp> in a buffer with extent __e.
+    optional_view(const byte* __p, serial_extent __e)
+        : _M_p(__p), _M_extent(__e), _M_engaged(__p[0] != byte{0})
+    {
+        if (__p[0] > byte{1}) {
+            __throw_invalid_argument("optional_view: invalid engaged byte");
+        }
+    }
+
+    // Checked: __bytes must begin with a whole, aligned slot, for example
+    // one found in a memory-mapped file.
+    explicit
+    optional_view(span<const byte> __bytes, serial_extent __e = {})
+        : optional_view(
+              __detail::__serial::__checked_slot<optional<_Tp>>(__bytes), __e)
+    { }
+
+    bool has_value() const noexcept { return _M_engaged; }
+
+    explicit operator bool() const noexcept { return _M_engaged; }
+
+    view_type
+    operator*() const
+    {
+        __glibcxx_assert(_M_engaged);
+        return _Traits::decode(_M_p + serial_traits<optional<_Tp>>::_S_offset,
+                               _M_extent);
+    }
+
+    const _Tp*
+    operator->() const
+    requires is_reference_v<view_type>
+    {
+        return std::__addressof(**this);
+    }
+
+    view_type
+    value() const
+    {
+        if (!_M_engaged) {
+            __throw_bad_optional_access();
+        }
+        return **this;
+    }
+
+    template<typename _Up>
+    _Tp
+    value_or(_Up&& __u) const
+    requires is_reference_v<view_type>
+    {
+        return _M_engaged ? **this : static_cast<_Tp>(std::forward<_Up>(__u));
+    }
+};
+
+/**
+  * @brief A serialized variant<_Types...>, read in place.
+  */
+template<typename... _Types>
+class variant_view
+{
+    const byte* _M_p;
+    serial_extent _M_extent;
+    uint32_t _M_index;
+
+public:
+    template<size_t _Np>
+    using _Alt = typename __detail::__variant::_Nth_type<_Np, _Types...>::type;
+
+    // __p is the slot of a variant<_Types...> in a buffer with extent __e.
+    variant_view(const byte* __p, serial_extent __e)
+        : _M_p(__p), _M_extent(__e)
+    {
+        __builtin_memcpy(&_M_index, __p, sizeof(_M_index));
+        if (_M_index >= sizeof...(_Types)) {
+            __throw_bad_variant_access("variant_view: index out of range");
+        }
+    }
+
+    // Checked: __bytes must begin with a whole, aligned slot, for example
+    // one found in a memory-mapped file.
+    explicit
+    variant_view(span<const byte> __bytes, serial_extent __e = {})
+        : variant_view(
+              __detail::__serial::__checked_slot<variant<_Types...>>(__bytes),
+              __e)
+    { }
+
+    size_t index() const noexcept { return _M_index; }
+
+    constexpr bool valueless_by_exception() const noexcept { return false; }
+
+    // Not part of the interface: the view of alternative _Np, which must be
+    // the one held.
+    template<size_t _Np>
+    typename serial_traits<_Alt<_Np>>::view_type
+    _M_get() const
+    {
+        return serial_traits<_Alt<_Np>>::decode(
+                   _M_p + serial_traits<variant<_Types...>>::_S_offset,
+                   _M_extent);
+    }
+};
+
+template<typename _Tp, typename... _Types>
+bool
+holds_alternative(const variant_view<_Types...>& __v) noexcept
+{
+    static_assert((is_same_v<_Tp, _Types> + ...) == 1,
+                  "T must occur exactly once in alternatives");
+    return __v.index() == __detail::__variant::__index_of_v<_Tp, _Types...>;
+}
+
+template<size_t _Np, typename... _Types>
+typename serial_traits<
+    typename __detail::__variant::_Nth_type<_Np, _Types...>::type>::view_type
+get(const variant_view<_Types...>& __v)
+{
+    static_assert(_Np < sizeof...(_Types),
+                  "The index must be in [0, number of alternatives)");
+    if (__v.index() != _Np) {
+        __throw_bad_variant_access(false);
+    }
+    return __v.template _M_get<_Np>();
+}
+
+template<typename _Tp, typename... _Types>
+typename serial_traits<_Tp>::view_type
+get(const variant_view<_Types...>& __v)
+{
+    static_assert((is_same_v<_Tp, _Types> + ...) == 1,
+                  "T must occur exactly once in alternatives");
+    return std::get<__detail::__variant::__index_of_v<_Tp, _Types...>>(__v);
+}
+
+template<size_t _Np, typename... _Types>
+requires is_reference_v<typename serial_traits<
+    typename __detail::__variant::_Nth_type<_Np, _Types...>::type>::view_type>
+const typename __detail::__variant::_Nth_type<_Np, _Types...>::type*
+get_if(const variant_view<_Types...>* __ptr) noexcept
+{
+    static_assert(_Np < sizeof...(_Types),
+                  "The index must be in [0, number of alternatives)");
+    if (__ptr && __ptr->index() == _Np) {
+        return std::__addressof(__ptr->template _M_get<_Np>());
+    }
+    return nullptr;
+}
+
+template<typename _Tp, typename... _Types>
+requires is_reference_v<typename serial_traits<_Tp>::view_type>
+const _Tp*
+get_if(const variant_view<_Types...>* __ptr) noexcept
+{
+    static_assert((is_same_v<_Tp, _Types> + ...) == 1,
+                  "T must occur exactly once in alternatives");
+    return std::get_if<__detail::__variant::__index_of_v<_Tp, _Types...>>(
+               __ptr);
+}
+
+// Invokes __vis with the view of the held alternative: a const reference
+// into the buffer for trivially copyable alternatives. The view is taken
+// by value so that this is preferred over visit for variants.
+template<typename _Visitor, typename... _Types>
+decltype(auto)
+visit(_Visitor&& __vis, variant_view<_Types...> __v)
+{
+    using _View = variant_view<_Types...>;
+    using _Res = invoke_result_t<_Visitor,
+        typename serial_traits<typename _View::template _Alt<0>>::view_type>;
+    using _Table = __detail::__serial::__vtable<_Res, _Visitor, _View,
+                                                index_sequence_for<_Types...>>;
+    return _Table::_S_table[__v.index()](std::forward<_Visitor>(__vis), __v);
+}
+
+template<typename... _Types>
+struct variant_size<variant_view<_Types...>>
+    : std::integral_constant<size_t, sizeof...(_Types)> {};
+
+/**
+  * @brief The records of a serialized buffer, read in place.
+  */
+template<typename _Tp>
+class serial_array
+{
+    using _Traits = serial_traits<_Tp>;
+
+    const byte* _M_records = nullptr;
+    size_t _M_count = 0;
+    serial_extent _M_extent = {};
+
+public:
+    using value_type = _Tp;
+    using view_type = typename _Traits::view_type;
+    using size_type = size_t;
+
+    class iterator
+    {
+        const serial_array* _M_a = nullptr;
+        size_t _M_i = 0;
+
+    public:
+        using iterator_concept = forward_iterator_tag;
+        using iterator_category = input_iterator_tag;
+        using value_type = remove_cvref_t<view_type>;
+        using difference_type = ptrdiff_t;
+
+        iterator() = default;
+
+        iterator(const serial_array* __a, size_t __i) noexcept
+            : _M_a(__a), _M_i(__i)
+        { }
+
+        view_type operator*() const { return (*_M_a)[_M_i]; }
+
+        iterator& operator++() noexcept { ++_M_i; return *this; }
+
+        iterator operator++(int) noexcept { return { _M_a, _M_i++ }; }
+
+        friend bool
+        operator==(const iterator& __x, const iterator& __y) noexcept
+        {
+            return __x._M_i == __y._M_i;
+        }
+    };
+
+    serial_array() = default;
+
+    serial_array(const byte* __records, size_t __count,
+                 serial_extent __e) noexcept
+        : _M_records(__records), _M_count(__count), _M_extent(__e)
+    { }
+
+    size_type size() const noexcept { return _M_count; }
+
+    bool empty() const noexcept { return _M_count == 0; }
+
+    view_type
+    operator[](size_type __i) const
+    {
+        __glibcxx_assert(__i < _M_count);
+        return _Traits::decode(_M_records + __i * _Traits::size, _M_extent);
+    }
+
+    iterator begin() const noexcept { return { this, 0 }; }
+
+    iterator end() const noexcept { return { this, _M_count }; }
+};
+
+namespace __detail
+{
+namespace __serial
+{
+template<typename _Tp>
+constexpr size_t __records_offset =
+    __round_up(sizeof(serial_header), serial_traits<_Tp>::alignment);
+
+template<typename _Tp>
+size_t
+__total_extent(span<const _Tp> __in)
+{
+    size_t __n = 0;
+    if constexpr (__has_extent<_Tp>) {
+        for (const _Tp& __t : __in) {
+            __n += serial_traits<_Tp>::extent_size(__t);
+        }
+    }
+    return __n;
+}
+} // namespace __serial
+} // namespace __detail
+
+/// The number of bytes serialize writes for __in.
+template<typename _Tp>
+size_t
+serialized_size(span<const _Tp> __in)
+{
+    return __detail::__serial::__records_offset<_Tp>
+           + __in.size() * serial_traits<_Tp>::size
+           + __detail::__serial::__total_extent(__in);
+}
+
+/**
+  * @brief Writes __in to __out and returns the number of bytes written.
+  *
+  * __out must be aligned to serial_traits<_Tp>::alignment and hold at
+  * least serialized_size(__in) bytes.
+  */
+template<typename _Tp>
+size_t
+serialize(span<const _Tp> __in, span<byte> __out)
+{
+    using _Traits = serial_traits<_Tp>;
+    constexpr size_t __off = __detail::__serial::__records_offset<_Tp>;
+
+    const size_t __extent = __detail::__serial::__total_extent(__in);
+    const size_t __records = __in.size() * _Traits::size;
+    const size_t __total = __off + __records + __extent;
+    if (__out.size() < __total) {
+        __throw_length_error("serialize: output buffer too small");
+    }
+    if (reinterpret_cast<uintptr_t>(__out.data()) % _Traits::alignment) {
+        __throw_invalid_argument("serialize: output buffer misaligned");
+    }
+
+    serial_header __h = {};
+    __h.magic = __detail::__serial::__magic;
+    __h.version = serial_version;
+    __h.endian = __detail::__serial::__native_endian();
+    __h.align_log2 = std::countr_zero(_Traits::alignment);
+    __h.record_size = _Traits::size;
+    __h.count = __in.size();
+    __h.extent_size = __extent;
+    __builtin_memset(__out.data(), 0, __off);
+    __builtin_memcpy(__out.data(), &__h, sizeof(__h));
+
+    byte* __p = __out.data() + __off;
+    serial_extent_writer __w(__p + __records);
+    for (const _Tp& __t : __in) {
+        _Traits::encode(__t, __p, __w);
+        __p += _Traits::size;
+    }
+    return __total;
+}
+
+/**
+  * @brief Checks the header of __in and returns views of its records.
+  *
+  * Throws invalid_argument if __in was not written by serialize for _Tp,
+  * in this byte order, or is misaligned or truncated.
+  */
+template<typename _Tp>
+serial_array<_Tp>
+deserialize(span<const byte> __in)
+{
+    using _Traits = serial_traits<_Tp>;
+    constexpr size_t __off = __detail::__serial::__records_offset<_Tp>;
+
+    if (__in.size() < __off) {
+        __throw_invalid_argument("deserialize: buffer too small");
+    }
+    serial_header __h;
+    __builtin_memcpy(&__h, __in.data(), sizeof(__h));
+    if (__h.magic != __detail::__serial::__magic
+        || __h.endian != __detail::__serial::__native_endian()) {
+        __throw_invalid_argument("deserialize: not a buffer in this byte order");
+    }
+    if (__h.version != serial_version) {
+        __throw_invalid_argument("deserialize: unsupported version");
+    }
+    if (__h.record_size != _Traits::size
+        || __h.align_log2 != std::countr_zero(_Traits::alignment)) {
+        __throw_invalid_argument("deserialize: layout does not match type");
+    }
+    if (reinterpret_cast<uintptr_t>(__in.data()) % _Traits::alignment) {
+        __throw_invalid_argument("deserialize: buffer misaligned");
+    }
+    const size_t __avail = __in.size() - __off;
+    if (__h.count > __avail / _Traits::size
+        || __h.extent_size > __avail - __h.count * _Traits::size) {
+        __throw_invalid_argument("deserialize: buffer truncated");
+    }
+
+    const byte* __records = __in.data() + __off;
+    const size_t __records_size = __h.count * _Traits::size;
+    return serial_array<_Tp>(__records, __h.count,
+                             { __records + __records_size, __h.extent_size });
+}
+
+_GLIBCXX_END_NAMESPACE_VERSION
+} // namespace std
+
+#endif // C++20
+
+#endif // _GLIBCXX_SERIALIZED_OPTIONAL_VARIANT
@@ -0,0 +1,330 @@
+#ifndef _GLIBCXX_SHARED_OPTIONAL_VARIANT
+#define _GLIBCXX_SHARED_OPTIONAL_VARIANT 1
+
+#if __cplusplus > 201703L
+
+#include <atomic>
+#include <cstdint>
+#include "fixed_optional.h"
+#include "fixed_variant.h"
+
+namespace std _GLIBCXX_VISIBILITY(default)
+{
+_GLIBCXX_BEGIN_NAMESPACE_VERSION
+
+namespace __detail
+{
+namespace __shared_value
+{
+// A sequence lock over two buffers, for read-mostly values.
+//
+// _M_seq is odd while a writer is active. Bit 1 of _M_seq selects the
+// published buffer, and a writer only ever fills the other one, so readers
+// keep reading the published buffer while a write is in progress. A read
+// that started at sequence __s is valid as long as no writer has begun
+// filling the buffer it read from, i.e. the sequence has not reached
+// (__s | 1) + 2.
+//
+// Readers only load _M_seq and never write to shared memory, so they do
+// not contend with each other. The price is that the value may be read
+// while a (much later) writer overwrites it, so the payload must be
+// trivially copyable and the reader may run more than once.
+template<typename _Value>
+class _Seqlock_buffers {
+protected:
+    alignas(64) atomic<uint64_t> _M_seq{0};
+    alignas(64) _Value _M_buf[2];
+
+    template<typename... _Args>
+    constexpr explicit
+    _Seqlock_buffers(_Args&&... __args)
+        : _M_buf{ _Value(std::forward<_Args>(__args)...), _Value() }
+    { }
+
+    // Calls __read(const _Value&) on the published buffer until it completes
+    // without a concurrent writer reusing that buffer.
+    template<typename _Read>
+    decltype(auto)
+    _M_read(_Read&& __read) const
+    {
+        for (;;) {
+            uint64_t __s = _M_seq.load(memory_order_acquire);
+            const _Value& __v = _M_buf[(__s >> 1) & 1];
+            if constexpr (is_void_v<invoke_result_t<_Read&, const _Value&>>) {
+                __read(__v);
+                atomic_thread_fence(memory_order_acquire);
+                if (_M_seq.load(memory_order_relaxed) < (__s | 1) + 2) {
+                    return;
+                }
+            } else {
+                auto __r = __read(__v);
+                atomic_thread_fence(memory_order_acquire);
+                if (_M_seq.load(memory_order_relaxed) < (__s | 1) + 2) {
+                    return __r;
+                }
+            }
+        }
+    }
+
+    // Calls __write(_Value&) on the unpublished buffer, then publishes it.
+    // Writers are serialized by making _M_seq odd.
+    template<typename _Write>
+    void
+    _M_write(_Write&& __write)
+    {
+        uint64_t __s = _M_seq.load(memory_order_relaxed);
+        for (;;) {
+            if (__s & 1) {
+                __s = _M_seq.load(memory_order_relaxed);
+            } else if (_M_seq.compare_exchange_weak(__s, __s + 1,
+                       memory_order_acquire,
+                       memory_order_relaxed)) {
+                break;
+            }
+        }
+        atomic_thread_fence(memory_order_release);
+        __try {
+            __write(_M_buf[((__s >> 1) + 1) & 1]);
+        }
+        __catch (...) {
+            // Nothing was published. Advance by two whole cycles, which
+            // keeps the same buffer published and _M_seq monotonic.
+            _M_seq.store(__s + 4, memory_order_release);
+            __throw_exception_again;
+        }
+        _M_seq.store(__s + 2, memory_order_release);
+    }
+};
+
+} // namespace __shared_value
+} // namespace __detail
+
+/**
+  * @brief Variant for values that are read by many threads and rarely
+  * replaced, synchronized by a sequence lock over two buffers.
+  *
+  * visit() invokes the visitor directly on the published alternative, with
+  * no copy and no write to shared memory. The visitor must not have side
+  * effects other than its result: if a writer reused the buffer meanwhile
+  * the result is discarded and the visitor is called again. All
+  * alternatives must be trivially copyable.
+  */
+template<typename... _Types>
+class shared_variant
+    : private __detail::__shared_value::_Seqlock_buffers<variant<_Types...>>
+{
+    static_assert((is_trivially_copyable_v<_Types> && ...),
+                  "shared_variant requires trivially copyable alternatives");
+
+    using _Base =
+        __detail::__shared_value::_Seqlock_buffers<variant<_Types...>>;
+
+    // Dispatch on an index that was read once and bounds-checked, so a
+    // torn buffer can never select an invalid table entry.
+    template<size_t _Np, typename _Res, typename _Visitor>
+    static _Res
+    _S_visit_alt(_Visitor& __vis, const variant<_Types...>& __v)
+    {
+        return std::__invoke_r<_Res>(__vis,
+                                     __detail::__variant::__get<_Np>(__v));
+    }
+
+    template<typename _Res, typename _Visitor, size_t... _Ind>
+    static _Res
+    _S_visit(_Visitor& __vis, const variant<_Types...>& __v, size_t __i,
+             index_sequence<_Ind...>)
+    {
+        using _Fn = _Res (*)(_Visitor&, const variant<_Types...>&);
+        static constexpr _Fn __table[] = {
+            &_S_visit_alt<_Ind, _Res, _Visitor>...
+        };
+        return __table[__i](__vis, __v);
+    }
+
+public:
+    using value_type = variant<_Types...>;
+
+    constexpr shared_variant() = default;
+
+    template<size_t _Np, typename... _Args>
+    constexpr explicit
+    shared_variant(in_place_index_t<_Np> __i, _Args&&... __args)
+        : _Base(__i, std::forward<_Args>(__args)...)
+    { }
+
+    template<typename _Tp, typename... _Args>
+    constexpr explicit
+    shared_variant(in_place_type_t<_Tp> __t, _Args&&... __args)
+        : _Base(__t, std::forward<_Args>(__args)...)
+    { }
+
+    constexpr
+    shared_variant(const variant<_Types...>& __v)
+        : _Base(__v)
+    { }
+
+    shared_variant(const shared_variant&) = delete;
+    shared_variant& operator=(const shared_variant&) = delete;
+
+    template<typename _Visitor>
+    decltype(auto)
+    visit(_Visitor&& __vis) const
+    {
+        using _Res = invoke_result_t<_Visitor&,
+              const variant_alternative_t<0, variant<_Types...>>&>;
+        static_assert((is_same_v<_Res, invoke_result_t<_Visitor&,
+                                                       const _Types&>> && ...),
+                      "shared_variant::visit requires the visitor to have "
+                      "the same return type for all alternatives");
+        return this->_M_read([&__vis](const variant<_Types...>& __v) -> _Res {
+            size_t __i = __v.index();
+            if (__i >= sizeof...(_Types)) [[__unlikely__]] {
+                __i = 0; // Torn read, the result will be discarded.
+            }
+            return _S_visit<_Res>(__vis, __v, __i,
+                                  index_sequence_for<_Types...>());
+        });
+    }
+
+    variant<_Types...>
+    load() const
+    {
+        return this->_M_read([](const variant<_Types...>& __v) {
+            return __v;
+        });
+    }
+
+    size_t
+    index() const
+    {
+        return this->_M_read([](const variant<_Types...>& __v) {
+            return __v.index();
+        });
+    }
+
+    void
+    store(const variant<_Types...>& __v)
+    {
+        this->_M_write([&__v](variant<_Types...>& __buf) {
+            __buf = __v;
+        });
+    }
+
+    template<size_t _Np, typename... _Args>
+    void
+    emplace(_Args&&... __args)
+    {
+        this->_M_write([&](variant<_Types...>& __buf) {
+            __buf.template emplace<_Np>(std::forward<_Args>(__args)...);
+        });
+    }
+
+    template<typename _Tp, typename... _Args>
+    void
+    emplace(_Args&&... __args)
+    {
+        this->_M_write([&](variant<_Types...>& __buf) {
+            __buf.template emplace<_Tp>(std::forward<_Args>(__args)...);
+        });
+    }
+};
+
+/**
+  * @brief Optional for values that are read by many threads and rarely
+  * replaced, see shared_variant.
+  */
+template<typename _Tp>
+class shared_optional
+    : private __detail::__shared_value::_Seqlock_buffers<optional<_Tp>>
+{
+    static_assert(is_trivially_copyable_v<_Tp>,
+                  "shared_optional requires a trivially copyable type");
+
+    using _Base = __detail::__shared_value::_Seqlock_buffers<optional<_Tp>>;
+
+public:
+    using value_type = optional<_Tp>;
+
+    constexpr shared_optional() = default;
+
+    constexpr
+    shared_optional(nullopt_t)
+    { }
+
+    template<typename... _Args>
+    constexpr explicit
+    shared_optional(in_place_t __t, _Args&&... __args)
+        : _Base(__t, std::forward<_Args>(__args)...)
+    { }
+
+    constexpr
+    shared_optional(const optional<_Tp>& __v)
+        : _Base(__v)
+    { }
+
+    shared_optional(const shared_optional&) = delete;
+    shared_optional& operator=(const shared_optional&) = delete;
+
+    // Invokes __vis with the contained value, or with nullopt if there is
+    // none.
+    template<typename _Visitor>
+    decltype(auto)
+    visit(_Visitor&& __vis) const
+    {
+        using _Res = invoke_result_t<_Visitor&, const _Tp&>;
+        return this->_M_read([&__vis](const optional<_Tp>& __v) -> _Res {
+            if (__v) {
+                return std::__invoke_r<_Res>(__vis, *__v);
+            }
+            return std::__invoke_r<_Res>(__vis, nullopt);
+        });
+    }
+
+    optional<_Tp>
+    load() const
+    {
+        return this->_M_read([](const optional<_Tp>& __v) {
+            return __v;
+        });
+    }
+
+    bool
+    has_value() const
+    {
+        return this->_M_read([](const optional<_Tp>& __v) {
+            return __v.has_value();
+        });
+    }
+
+    void
+    store(const optional<_Tp>& __v)
+    {
+        this->_M_write([&__v](optional<_Tp>& __buf) {
+            __buf = __v;
+        });
+    }
+
+    template<typename... _Args>
+    void
+    emplace(_Args&&... __args)
+    {
+        this->_M_write([&](optional<_Tp>& __buf) {
+            __buf.emplace(std::forward<_Args>(__args)...);
+        });
+    }
+
+    void
+    reset()
+    {
+        this->_M_write([](optional<_Tp>& __buf) {
+            __buf.reset();
+        });
+    }
+};
+
+_GLIBCXX_END_NAMESPACE_VERSION
+} // namespace std
+
+#endif // C++20
+
+#endif // _GLIBCXX_SHARED_OPTIONAL_VARIANT
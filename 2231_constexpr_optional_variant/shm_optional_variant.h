@@ -0,0 +1,801 @@
+#ifndef _GLIBCXX_SHM_OPTIONAL_VARIANT
+#define _GLIBCXX_SHM_OPTIONAL_VARIANT 1
+
+#if __cplusplus > 201703L
+
+#include <atomic>
+#include <bit>
+#include <cerrno>
+#include <cstdint>
+#include <new>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include "fixed_optional.h"
+#include "fixed_variant.h"
+#include "shared_optional_variant.h"
+
+namespace std _GLIBCXX_VISIBILITY(default)
+{
+_GLIBCXX_BEGIN_NAMESPACE_VERSION
+
+// Optionals, variants and a publish/subscribe ring that can be placed in
+// POSIX shared memory and used by several processes at once.
+//
+// An object in shared memory is mapped at a different address in each
+// process, so it must not contain pointers into the segment, and it is
+// accessed concurrently by processes that share no locks, so it must be
+// synchronized by lock-free (and so address-free) atomics alone:
+//
+//   shm_variant and shm_optional have a fixed layout of an explicit 32-bit
+//   index or engaged byte next to the payload, which does not depend on the
+//   layout of variant or optional, and are published through the two-buffer
+//   sequence lock of shared_variant.
+//
+//   shm_variant_ring is a bounded ring written by one producer and read by
+//   any number of subscribers, each with its own cursor. The producer never
+//   waits: a subscriber that falls more than the capacity behind skips the
+//   overwritten messages and counts them.
+//
+// Alternatives must be trivially copyable and must not hold raw pointers;
+// offset_ptr refers to other objects in the same segment. shm_object
+// creates or opens a named segment holding one such object.
+//
+// A process that dies while writing leaves the object locked, or the
+// ring cell being written unreadable, until the segment is recreated.
+
+/**
+  * @brief A pointer stored as the distance from itself, which stays valid
+  * wherever the segment holding both it and its target is mapped.
+  */
+template<typename _Tp>
+class offset_ptr
+{
+    // Null is 1, which would point into this offset_ptr itself and so
+    // never refers to another object.
+    ptrdiff_t _M_off = 1;
+
+    void
+    _M_set(_Tp* __p) noexcept
+    {
+        _M_off = __p ? ptrdiff_t(reinterpret_cast<uintptr_t>(__p)
+                                 - reinterpret_cast<uintptr_t>(this))
+                     : 1;
+    }
+
+public:
+    using element_type = _Tp;
+
+    offset_ptr() = default;
+
+    offset_ptr(nullptr_t) noexcept { }
+
+    offset_ptr(_Tp* __p) noexcept { _M_set(__p); }
+
+    offset_ptr(const offset_ptr& __p) noexcept { _M_set(__p.get()); }
+
+    offset_ptr&
+    operator=(const offset_ptr& __p) noexcept
+    {
+        _M_set(__p.get());
+        return *this;
+    }
+
+    offset_ptr&
+    operator=(_Tp* __p) noexcept
+    {
+        _M_set(__p);
+        return *this;
+    }
+
+    _Tp*
+    get() const noexcept
+    {
+        if (_M_off == 1) {
+            return nullptr;
+        }
+        return reinterpret_cast<_Tp*>(reinterpret_cast<uintptr_t>(this)
+                                      + _M_off);
+    }
+
+    _Tp& operator*() const noexcept { return *get(); }
+
+    _Tp* operator->() const noexcept { return get(); }
+
+    explicit operator bool() const noexcept { return _M_off != 1; }
+
+    friend bool
+    operator==(const offset_ptr& __x, const offset_ptr& __y) noexcept
+    {
+        return __x.get() == __y.get();
+    }
+};
+
+namespace __detail
+{
+namespace __shm
+{
+static_assert(atomic<uint64_t>::is_always_lock_free
+              && atomic<uint32_t>::is_always_lock_free,
+              "shared memory objects require lock-free atomics");
+
+template<typename _Tp>
+inline constexpr bool __is_offset_ptr = false;
+
+template<typename _Tp>
+inline constexpr bool __is_offset_ptr<offset_ptr<_Tp>> = true;
+
+template<typename _Tp>
+inline constexpr bool __shareable
+    = is_trivially_copyable_v<_Tp> || __is_offset_ptr<_Tp>;
+
+template<typename... _Sizes>
+constexpr size_t
+__max(_Sizes... __sizes) noexcept
+{
+    size_t __m = 0;
+    ((__m = __m < __sizes ? __sizes : __m), ...);
+    return __m;
+}
+
+// The stored form of a variant<_Types...>: the payload, then the index.
+// Alternatives are constructed in place, so that offset_ptr is copied
+// relative to its final address. Padding is zeroed.
+template<typename... _Types>
+struct _Variant_slot {
+    static_assert((__shareable<_Types> && ...),
+                  "shm_variant alternatives must be trivially copyable or"
+                  " offset_ptr");
+
+    template<size_t _Np>
+    using _Alt = typename __variant::_Nth_type<_Np, _Types...>::type;
+
+    alignas(_Types...) unsigned char _M_payload[__max(sizeof(_Types)...)];
+    uint32_t _M_index;
+
+    _Variant_slot()
+        : _Variant_slot(in_place_index<0>)
+    { }
+
+    template<size_t _Np, typename... _Args>
+    explicit
+    _Variant_slot(in_place_index_t<_Np>, _Args&&... __args)
+        : _M_payload(), _M_index(_Np)
+    {
+        ::new (_M_payload) _Alt<_Np>(std::forward<_Args>(__args)...);
+    }
+
+    template<typename _Tp, typename... _Args>
+    explicit
+    _Variant_slot(in_place_type_t<_Tp>, _Args&&... __args)
+        : _Variant_slot(in_place_index<__variant::__index_of_v<_Tp, _Types...>>,
+                        std::forward<_Args>(__args)...)
+    { }
+
+    explicit
+    _Variant_slot(const variant<_Types...>& __v)
+        : _M_payload(), _M_index(0)
+    {
+        _M_assign(__v);
+    }
+
+    _Variant_slot(const _Variant_slot&) = delete;
+    _Variant_slot& operator=(const _Variant_slot&) = delete;
+
+    template<size_t _Np>
+    const _Alt<_Np>&
+    _M_get() const noexcept
+    {
+        return *std::launder(reinterpret_cast<const _Alt<_Np>*>(_M_payload));
+    }
+
+    template<size_t _Np, typename... _Args>
+    void
+    _M_emplace(_Args&&... __args)
+    {
+        __builtin_memset(_M_payload, 0, sizeof(_M_payload));
+        ::new (_M_payload) _Alt<_Np>(std::forward<_Args>(__args)...);
+        _M_index = _Np;
+    }
+
+    void
+    _M_assign(const variant<_Types...>& __v)
+    {
+        if (__v.valueless_by_exception()) {
+            __throw_bad_variant_access("shm_variant: variant is valueless");
+        }
+        __variant::__raw_idx_visit(
+        [this](const auto& __alt, auto __i) {
+            if constexpr (__i != variant_npos) {
+                _M_emplace<__i>(__alt);
+            }
+        }, __v);
+    }
+
+    // Calls __f(integral_constant<size_t, index()>) through a table, like
+    // shared_variant::visit. An index torn by a concurrent writer selects
+    // alternative 0, and the sequence lock discards the result.
+    template<typename _Res, typename _Fn>
+    _Res
+    _M_dispatch(_Fn& __f) const
+    {
+        size_t __i = _M_index;
+        if (__i >= sizeof...(_Types)) [[__unlikely__]] {
+            __i = 0;
+        }
+        return _S_dispatch<_Res>(__f, __i, index_sequence_for<_Types...>());
+    }
+
+    template<typename _Res, typename _Fn, size_t... _Ind>
+    static _Res
+    _S_dispatch(_Fn& __f, size_t __i, index_sequence<_Ind...>)
+    {
+        using _Ptr = _Res (*)(_Fn&);
+        static constexpr _Ptr __table[] = {
+            [](_Fn& __g) -> _Res {
+                return __g(integral_constant<size_t, _Ind>());
+            }...
+        };
+        return __table[__i](__f);
+    }
+
+    template<typename _Res, typename _Visitor>
+    _Res
+    _M_visit(_Visitor& __vis) const
+    {
+        auto __f = [this, &__vis](auto __i) -> _Res {
+            return std::__invoke_r<_Res>(__vis, _M_get<__i>());
+        };
+        return _M_dispatch<_Res>(__f);
+    }
+
+    variant<_Types...>
+    _M_load() const
+    {
+        auto __f = [this](auto __i) {
+            return variant<_Types...>(in_place_index<__i>, _M_get<__i>());
+        };
+        return _M_dispatch<variant<_Types...>>(__f);
+    }
+};
+
+// The stored form of an optional<_Tp>: the payload, then the engaged byte.
+template<typename _Tp>
+struct _Optional_slot {
+    static_assert(__shareable<_Tp>,
+                  "shm_optional requires a trivially copyable type or"
+                  " offset_ptr");
+
+    alignas(_Tp) unsigned char _M_payload[sizeof(_Tp)];
+    uint8_t _M_engaged;
+
+    _Optional_slot()
+        : _M_payload(), _M_engaged(0)
+    { }
+
+    template<typename... _Args>
+    explicit
+    _Optional_slot(in_place_t, _Args&&... __args)
+        : _M_payload(), _M_engaged(1)
+    {
+        ::new (_M_payload) _Tp(std::forward<_Args>(__args)...);
+    }
+
+    explicit
+    _Optional_slot(const optional<_Tp>& __o)
+        : _M_payload(), _M_engaged(0)
+    {
+        _M_assign(__o);
+    }
+
+    _Optional_slot(const _Optional_slot&) = delete;
+    _Optional_slot& operator=(const _Optional_slot&) = delete;
+
+    // Null if disengaged.
+    const _Tp*
+    _M_ptr() const noexcept
+    {
+        if (!_M_engaged) {
+            return nullptr;
+        }
+        return std::launder(reinterpret_cast<const _Tp*>(_M_payload));
+    }
+
+    template<typename... _Args>
+    void
+    _M_emplace(_Args&&... __args)
+    {
+        __builtin_memset(_M_payload, 0, sizeof(_M_payload));
+        ::new (_M_payload) _Tp(std::forward<_Args>(__args)...);
+        _M_engaged = 1;
+    }
+
+    void
+    _M_reset() noexcept
+    {
+        __builtin_memset(_M_payload, 0, sizeof(_M_payload));
+        _M_engaged = 0;
+    }
+
+    void
+    _M_assign(const optional<_Tp>& __o)
+    {
+        if (__o) {
+            _M_emplace(*__o);
+        } else {
+            _M_reset();
+        }
+    }
+
+    optional<_Tp>
+    _M_load() const
+    {
+        if (const _Tp* __p = _M_ptr()) {
+            return optional<_Tp>(*__p);
+        }
+        return nullopt;
+    }
+};
+
+} // namespace __shm
+} // namespace __detail
+
+/**
+  * @brief Variant in shared memory, read and written by several processes,
+  * see shared_variant.
+  */
+template<typename... _Types>
+class shm_variant
+    : private __detail::__shared_value::_Seqlock_buffers<
+                  __detail::__shm::_Variant_slot<_Types...>>
+{
+    using _Slot = __detail::__shm::_Variant_slot<_Types...>;
+    using _Base = __detail::__shared_value::_Seqlock_buffers<_Slot>;
+
+public:
+    using value_type = variant<_Types...>;
+
+    shm_variant() = default;
+
+    template<size_t _Np, typename... _Args>
+    explicit
+    shm_variant(in_place_index_t<_Np> __i, _Args&&... __args)
+        : _Base(__i, std::forward<_Args>(__args)...)
+    { }
+
+    template<typename _Tp, typename... _Args>
+    explicit
+    shm_variant(in_place_type_t<_Tp> __t, _Args&&... __args)
+        : _Base(__t, std::forward<_Args>(__args)...)
+    { }
+
+    shm_variant(const variant<_Types...>& __v)
+        : _Base(__v)
+    { }
+
+    shm_variant(const shm_variant&) = delete;
+    shm_variant& operator=(const shm_variant&) = delete;
+
+    // Invokes __vis on the published alternative in place. As with
+    // shared_variant, __vis may be called again if a writer intervenes.
+    template<typename _Visitor>
+    decltype(auto)
+    visit(_Visitor&& __vis) const
+    {
+        using _Res = invoke_result_t<_Visitor&,
+              const variant_alternative_t<0, variant<_Types...>>&>;
+        static_assert((is_same_v<_Res, invoke_result_t<_Visitor&,
+                                                       const _Types&>> && ...),
+                      "shm_variant::visit requires the visitor to have "
+                      "the same return type for all alternatives");
+        return this->_M_read([&__vis](const _Slot& __s) -> _Res {
+            return __s.template _M_visit<_Res>(__vis);
+        });
+    }
+
+    variant<_Types...>
+    load() const
+    {
+        return this->_M_read([](const _Slot& __s) {
+            return __s._M_load();
+        });
+    }
+
+    size_t
+    index() const
+    {
+        return this->_M_read([](const _Slot& __s) -> size_t {
+            return __s._M_index;
+        });
+    }
+
+    void
+    store(const variant<_Types...>& __v)
+    {
+        this->_M_write([&__v](_Slot& __s) {
+            __s._M_assign(__v);
+        });
+    }
+
+    template<size_t _Np, typename... _Args>
+    void
+    emplace(_Args&&... __args)
+    {
+        this->_M_write([&](_Slot& __s) {
+            __s.template _M_emplace<_Np>(std::forward<_Args>(__args)...);
+        });
+    }
+
+    template<typename _Tp, typename... _Args>
+    void
+    emplace(_Args&&... __args)
+    {
+        emplace<__detail::__variant::__index_of_v<_Tp, _Types...>>(
+            std::forward<_Args>(__args)...);
+    }
+};
+
+/**
+  * @brief Optional in shared memory, read and written by several
+  * processes, see shared_optional.
+  */
+template<typename _Tp>
+class shm_optional
+    : private __detail::__shared_value::_Seqlock_buffers<
+                  __detail::__shm::_Optional_slot<_Tp>>
+{
+    using _Slot = __detail::__shm::_Optional_slot<_Tp>;
+    using _Base = __detail::__shared_value::_Seqlock_buffers<_Slot>;
+
+public:
+    using value_type = optional<_Tp>;
+
+    shm_optional() = default;
+
+    shm_optional(nullopt_t)
+    { }
+
+    template<typename... _Args>
+    explicit
+    shm_optional(in_place_t __t, _Args&&... __args)
+        : _Base(__t, std::forward<_Args>(__args)...)
+    { }
+
+    shm_optional(const optional<_Tp>& __o)
+        : _Base(__o)
+    { }
+
+    shm_optional(const shm_optional&) = delete;
+    shm_optional& operator=(const shm_optional&) = delete;
+
+    // Invokes __vis with the contained value, or with nullopt if there is
+    // none.
+    template<typename _Visitor>
+    decltype(auto)
+    visit(_Visitor&& __vis) const
+    {
+        using _Res = invoke_result_t<_Visitor&, const _Tp&>;
+        static_assert(is_same_v<_Res, invoke_result_t<_Visitor&,
+                                                      const nullopt_t&>>,
+                      "shm_optional::visit requires the visitor to have "
+                      "the same return type for the value and nullopt");
+        return this->_M_read([&__vis](const _Slot& __s) -> _Res {
+            if (const _Tp* __p = __s._M_ptr()) {
+                return std::__invoke_r<_Res>(__vis, *__p);
+            }
+            return std::__invoke_r<_Res>(__vis, nullopt);
+        });
+    }
+
+    optional<_Tp>
+    load() const
+    {
+        return this->_M_read([](const _Slot& __s) {
+            return __s._M_load();
+        });
+    }
+
+    bool
+    has_value() const
+    {
+        return this->_M_read([](const _Slot& __s) {
+            return __s._M_engaged != 0;
+        });
+    }
+
+    void
+    store(const optional<_Tp>& __o)
+    {
+        this->_M_write([&__o](_Slot& __s) {
+            __s._M_assign(__o);
+        });
+    }
+
+    template<typename... _Args>
+    void
+    emplace(_Args&&... __args)
+    {
+        this->_M_write([&](_Slot& __s) {
+            __s._M_emplace(std::forward<_Args>(__args)...);
+        });
+    }
+
+    void
+    reset()
+    {
+        this->_M_write([](_Slot& __s) {
+            __s._M_reset();
+        });
+    }
+};
+
+/**
+  * @brief A bounded broadcast ring of variants in shared memory, written by
+  * one producer and read by any number of subscribers.
+  *
+  * Message __n goes to cell __n % _Cap, whose sequence number is 2__n + 1
+  * while it is written and 2__n + 2 once it is published. A subscriber
+  * expecting message __n reads the cell only when it holds exactly that
+  * number, and discards the copy if the number changed meanwhile.
+  */
+template<size_t _Cap, typename... _Types>
+class shm_variant_ring
+{
+    static_assert(std::has_single_bit(_Cap),
+                  "shm_variant_ring capacity must be a power of two");
+
+    using _Slot = __detail::__shm::_Variant_slot<_Types...>;
+
+    struct alignas(64) _Cell {
+        atomic<uint64_t> _M_seq{0};
+        _Slot _M_value;
+    };
+
+    alignas(64) atomic<uint64_t> _M_head{0};
+    _Cell _M_cells[_Cap];
+
+public:
+    using value_type = variant<_Types...>;
+
+    /// A process-local read position in a ring.
+    class subscriber
+    {
+        const shm_variant_ring* _M_ring;
+        uint64_t _M_next;
+        uint64_t _M_lost = 0;
+
+    public:
+        subscriber(const shm_variant_ring& __r, uint64_t __next) noexcept
+            : _M_ring(std::__addressof(__r)), _M_next(__next)
+        { }
+
+        // The next message, or nullopt if it has not been published yet.
+        optional<variant<_Types...>>
+        try_receive()
+        {
+            for (;;) {
+                const _Cell& __c = _M_ring->_M_cells[_M_next & (_Cap - 1)];
+                const uint64_t __want = 2 * _M_next + 2;
+                const uint64_t __s = __c._M_seq.load(memory_order_acquire);
+                if (__s < __want) {
+                    return nullopt;
+                }
+                if (__s == __want) {
+                    variant<_Types...> __v = __c._M_value._M_load();
+                    atomic_thread_fence(memory_order_acquire);
+                    if (__c._M_seq.load(memory_order_relaxed) == __want) {
+                        ++_M_next;
+                        return __v;
+                    }
+                }
+                // Overwritten: skip to the oldest message the producer is
+                // not about to overwrite.
+                const uint64_t __head
+                    = _M_ring->_M_head.load(memory_order_acquire);
+                const uint64_t __oldest
+                    = std::max(__head - (_Cap - 1), _M_next + 1);
+                _M_lost += __oldest - _M_next;
+                _M_next = __oldest;
+            }
+        }
+
+        // The number of messages skipped because they were overwritten
+        // before they were received.
+        uint64_t lost() const noexcept { return _M_lost; }
+    };
+
+    shm_variant_ring() = default;
+
+    shm_variant_ring(const shm_variant_ring&) = delete;
+    shm_variant_ring& operator=(const shm_variant_ring&) = delete;
+
+    static constexpr size_t capacity() noexcept { return _Cap; }
+
+    // A subscriber that receives the messages published from now on.
+    subscriber
+    subscribe() const noexcept
+    {
+        return subscriber(*this, _M_head.load(memory_order_acquire));
+    }
+
+    // Publishes a message. Only one process may publish to a ring.
+    void
+    publish(const variant<_Types...>& __v)
+    {
+        _M_publish([&__v](_Slot& __s) {
+            __s._M_assign(__v);
+        });
+    }
+
+    template<size_t _Np, typename... _Args>
+    void
+    emplace(_Args&&... __args)
+    {
+        _M_publish([&](_Slot& __s) {
+            __s.template _M_emplace<_Np>(std::forward<_Args>(__args)...);
+        });
+    }
+
+    template<typename _Tp, typename... _Args>
+    void
+    emplace(_Args&&... __args)
+    {
+        emplace<__detail::__variant::__index_of_v<_Tp, _Types...>>(
+            std::forward<_Args>(__args)...);
+    }
+
+private:
+    template<typename _Write>
+    void
+    _M_publish(_Write&& __write)
+    {
+        const uint64_t __n = _M_head.load(memory_order_relaxed);
+        _Cell& __c = _M_cells[__n & (_Cap - 1)];
+        __c._M_seq.store(2 * __n + 1, memory_order_relaxed);
+        atomic_thread_fence(memory_order_release);
+        __write(__c._M_value);
+        __c._M_seq.store(2 * __n + 2, memory_order_release);
+        _M_head.store(__n + 1, memory_order_release);
+    }
+};
+
+/**
+  * @brief One object of type _Tp in a named POSIX shared memory segment.
+  *
+  * create() makes the segment and constructs the object, open() maps an
+  * existing one. The object is marked ready only once it is constructed,
+  * and open() rejects a segment that is not ready or was created for a
+  * type of another size or alignment. Unmapping leaves the segment and the
+  * object in place; remove() unlinks the name.
+  */
+template<typename _Tp>
+class shm_object
+{
+    static_assert(is_trivially_destructible_v<_Tp>,
+                  "objects in shared memory are never destroyed");
+
+    struct _Header {
+        uint64_t _M_magic;
+        uint64_t _M_size;
+        uint64_t _M_align;
+        atomic<uint32_t> _M_ready;
+    };
+
+    static constexpr uint64_t _S_magic = 0x4d48535856584f46; // "FOXVXSHM"
+    static constexpr size_t _S_offset
+        = (sizeof(_Header) + alignof(_Tp) - 1) & ~(alignof(_Tp) - 1);
+    static constexpr size_t _S_length = _S_offset + sizeof(_Tp);
+
+    void* _M_addr = nullptr;
+
+    explicit
+    shm_object(int __fd)
+    {
+        _M_addr = ::mmap(nullptr, _S_length, PROT_READ | PROT_WRITE,
+                         MAP_SHARED, __fd, 0);
+        const int __err = errno;
+        ::close(__fd);
+        if (_M_addr == MAP_FAILED) {
+            _M_addr = nullptr;
+            __throw_system_error(__err);
+        }
+    }
+
+    _Header*
+    _M_header() const noexcept
+    {
+        return static_cast<_Header*>(_M_addr);
+    }
+
+public:
+    template<typename... _Args>
+    static shm_object
+    create(const char* __name, _Args&&... __args)
+    {
+        const int __fd = ::shm_open(__name, O_RDWR | O_CREAT | O_EXCL, 0600);
+        if (__fd < 0) {
+            __throw_system_error(errno);
+        }
+        if (::ftruncate(__fd, _S_length) != 0) {
+            const int __err = errno;
+            ::close(__fd);
+            ::shm_unlink(__name);
+            __throw_system_error(__err);
+        }
+        shm_object __o(__fd);
+        _Header* __h = ::new (__o._M_addr)
+            _Header{ _S_magic, sizeof(_Tp), alignof(_Tp), {0} };
+        ::new (static_cast<byte*>(__o._M_addr) + _S_offset)
+            _Tp(std::forward<_Args>(__args)...);
+        __h->_M_ready.store(1, memory_order_release);
+        return __o;
+    }
+
+    static shm_object
+    open(const char* __name)
+    {
+        const int __fd = ::shm_open(__name, O_RDWR, 0);
+        if (__fd < 0) {
+            __throw_system_error(errno);
+        }
+        struct ::stat __st;
+        if (::fstat(__fd, &__st) != 0 || size_t(__st.st_size) < _S_length) {
+            ::close(__fd);
+            __throw_invalid_argument("shm_object: segment too small");
+        }
+        shm_object __o(__fd);
+        const _Header* __h = __o._M_header();
+        if (!__h->_M_ready.load(memory_order_acquire)) {
+            __throw_invalid_argument("shm_object: segment not initialized");
+        }
+        if (__h->_M_magic != _S_magic || __h->_M_size != sizeof(_Tp)
+            || __h->_M_align != alignof(_Tp)) {
+            __throw_invalid_argument("shm_object: segment holds another type");
+        }
+        return __o;
+    }
+
+    // Unlinks the segment name. Existing mappings stay valid.
+    static void
+    remove(const char* __name) noexcept
+    {
+        ::shm_unlink(__name);
+    }
+
+    shm_object(shm_object&& __o) noexcept
+        : _M_addr(std::__exchange(__o._M_addr, nullptr))
+    { }
+
+    shm_object&
+    operator=(shm_object&& __o) noexcept
+    {
+        std::swap(_M_addr, __o._M_addr);
+        return *this;
+    }
+
+    ~shm_object()
+    {
+        if (_M_addr) {
+            ::munmap(_M_addr, _S_length);
+        }
+    }
+
+    _Tp*
+    get() const noexcept
+    {
+        return std::launder(reinterpret_cast<_Tp*>(
+                   static_cast<byte*>(_M_addr) + _S_offset));
+    }
+
+    _Tp& operator*() const noexcept { return *get(); }
+
+    _Tp* operator->() const noexcept { return get(); }
+};
+
+_GLIBCXX_END_NAMESPACE_VERSION
+} // namespace std
+
+#endif // C++20
+
+#endif // _GLIBCXX_SHM_OPTIONAL_VARIANT
@@ -0,0 +1,402 @@
+#ifndef _GLIBCXX_STRUCTURAL_OPTIONAL_VARIANT
+#define _GLIBCXX_STRUCTURAL_OPTIONAL_VARIANT 1
+
+#if __cplusplus > 201703L
+
+#include "fixed_optional.h"
+#include "fixed_variant.h"
+
+namespace std _GLIBCXX_VISIBILITY(default)
+{
+_GLIBCXX_BEGIN_NAMESPACE_VERSION
+
+// optional and variant keep their state in private bases, so they cannot
+// be the type of a non-type template parameter. structural_optional and
+// structural_variant hold the same state in public members only, which
+// makes them structural types whenever their payloads are, and convert to
+// and from optional and variant in constant expressions:
+//
+//   template<structural_variant<_Linear, _Exponential> _Cfg>
+//     double __kernel(double __x)
+//     { return std::visit(__step, _Cfg); } // No branch on _Cfg at run time.
+//
+// The members are public only to satisfy the structural type rules and
+// are not part of the interface.
+
+namespace __detail
+{
+namespace __structural
+{
+struct _Empty { };
+
+template<typename... _Types>
+union _Union { };
+
+template<typename _First, typename... _Rest>
+union _Union<_First, _Rest...> {
+    template<typename... _Args>
+    constexpr
+    _Union(in_place_index_t<0>, _Args&&... __args)
+        : _M_first(std::forward<_Args>(__args)...)
+    { }
+
+    template<size_t _Np, typename... _Args>
+    constexpr
+    _Union(in_place_index_t<_Np>, _Args&&... __args)
+        : _M_rest(in_place_index<_Np-1>, std::forward<_Args>(__args)...)
+    { }
+
+    _First _M_first;
+    _Union<_Rest...> _M_rest;
+};
+
+template<size_t _Np, typename _Union>
+constexpr const auto&
+__get(const _Union& __u) noexcept
+{
+    if constexpr (_Np == 0) {
+        return __u._M_first;
+    } else {
+        return __structural::__get<_Np-1>(__u._M_rest);
+    }
+}
+
+} // namespace __structural
+} // namespace __detail
+
+/**
+  * @brief Structural counterpart of optional, usable as a non-type
+  * template parameter.
+  */
+template<typename _Tp>
+struct structural_optional {
+    static_assert(is_trivially_destructible_v<_Tp>,
+                  "structural_optional requires a trivially destructible type");
+
+    union _Payload {
+        constexpr _Payload() noexcept : _M_empty() { }
+
+        template<typename... _Args>
+        constexpr
+        _Payload(in_place_t, _Args&&... __args)
+            : _M_value(std::forward<_Args>(__args)...)
+        { }
+
+        __detail::__structural::_Empty _M_empty;
+        _Tp _M_value;
+    };
+
+    using value_type = _Tp;
+
+    constexpr structural_optional() noexcept
+        : _M_payload(), _M_engaged(false)
+    { }
+
+    constexpr structural_optional(nullopt_t) noexcept
+        : structural_optional()
+    { }
+
+    constexpr structural_optional(const _Tp& __t)
+        : _M_payload(in_place, __t), _M_engaged(true)
+    { }
+
+    template<typename... _Args>
+    constexpr explicit
+    structural_optional(in_place_t, _Args&&... __args)
+        : _M_payload(in_place, std::forward<_Args>(__args)...),
+          _M_engaged(true)
+    { }
+
+    constexpr
+    structural_optional(const optional<_Tp>& __o)
+        : structural_optional()
+    {
+        if (__o) {
+            std::construct_at(std::__addressof(_M_payload), in_place, *__o);
+            _M_engaged = true;
+        }
+    }
+
+    constexpr
+    operator optional<_Tp>() const
+    {
+        if (_M_engaged) {
+            return optional<_Tp>(in_place, _M_payload._M_value);
+        }
+        return nullopt;
+    }
+
+    constexpr bool has_value() const noexcept { return _M_engaged; }
+
+    constexpr explicit operator bool() const noexcept { return _M_engaged; }
+
+    constexpr const _Tp&
+    operator*() const noexcept
+    {
+        __glibcxx_assert(_M_engaged);
+        return _M_payload._M_value;
+    }
+
+    constexpr const _Tp*
+    operator->() const noexcept
+    {
+        __glibcxx_assert(_M_engaged);
+        return std::__addressof(_M_payload._M_value);
+    }
+
+    constexpr const _Tp&
+    value() const
+    {
+        if (!_M_engaged) {
+            __throw_bad_optional_access();
+        }
+        return _M_payload._M_value;
+    }
+
+    template<typename _Up>
+    constexpr _Tp
+    value_or(_Up&& __u) const
+    {
+        return _M_engaged ? _M_payload._M_value
+                          : static_cast<_Tp>(std::forward<_Up>(__u));
+    }
+
+    friend constexpr bool
+    operator==(const structural_optional& __lhs,
+               const structural_optional& __rhs)
+    {
+        if (__lhs._M_engaged != __rhs._M_engaged) {
+            return false;
+        }
+        return !__lhs._M_engaged
+               || __lhs._M_payload._M_value == __rhs._M_payload._M_value;
+    }
+
+    _Payload _M_payload;
+    bool _M_engaged;
+};
+
+/**
+  * @brief Structural counterpart of variant, usable as a non-type
+  * template parameter.
+  */
+template<typename... _Types>
+struct structural_variant {
+    static_assert(sizeof...(_Types) > 0);
+    static_assert((is_trivially_destructible_v<_Types> && ...),
+                  "structural_variant requires trivially destructible"
+                  " alternatives");
+
+    using __index_type = __detail::__variant::__select_index<_Types...>;
+
+    template<size_t _Np>
+    using _Alt = typename __detail::__variant::_Nth_type<_Np, _Types...>::type;
+
+    template<typename _Tp>
+    static constexpr size_t _S_count = (is_same_v<_Tp, _Types> + ...);
+
+    template<size_t _Np>
+    static constexpr structural_variant
+    _S_from(const variant<_Types...>& __v)
+    {
+        if constexpr (_Np + 1 < sizeof...(_Types)) {
+            if (__v.index() != _Np) {
+                return _S_from<_Np + 1>(__v);
+            }
+        }
+        return structural_variant(in_place_index<_Np>, std::get<_Np>(__v));
+    }
+
+    template<size_t _Np, typename _Res, typename _Visitor>
+    constexpr _Res
+    _M_visit(_Visitor& __vis) const
+    {
+        if constexpr (_Np + 1 < sizeof...(_Types)) {
+            if (_M_index != _Np) {
+                return _M_visit<_Np + 1, _Res>(__vis);
+            }
+        }
+        return std::__invoke_r<_Res>(__vis,
+                   __detail::__structural::__get<_Np>(_M_u));
+    }
+
+    // By index rather than by type, since a type may occur more than once.
+    template<size_t _Np>
+    constexpr variant<_Types...>
+    _M_to_variant() const
+    {
+        if constexpr (_Np + 1 < sizeof...(_Types)) {
+            if (_M_index != _Np) {
+                return _M_to_variant<_Np + 1>();
+            }
+        }
+        return variant<_Types...>(in_place_index<_Np>,
+                                  __detail::__structural::__get<_Np>(_M_u));
+    }
+
+    // Precondition: __rhs has the same index.
+    template<size_t _Np>
+    constexpr bool
+    _M_equal(const structural_variant& __rhs) const
+    {
+        if constexpr (_Np + 1 < sizeof...(_Types)) {
+            if (_M_index != _Np) {
+                return _M_equal<_Np + 1>(__rhs);
+            }
+        }
+        return __detail::__structural::__get<_Np>(_M_u)
+               == __detail::__structural::__get<_Np>(__rhs._M_u);
+    }
+
+    constexpr structural_variant()
+    requires is_default_constructible_v<_Alt<0>>
+        : _M_u(in_place_index<0>), _M_index(0)
+    { }
+
+    template<size_t _Np, typename... _Args>
+    requires (_Np < sizeof...(_Types))
+    constexpr explicit
+    structural_variant(in_place_index_t<_Np>, _Args&&... __args)
+        : _M_u(in_place_index<_Np>, std::forward<_Args>(__args)...),
+          _M_index(_Np)
+    { }
+
+    template<typename _Tp, typename... _Args>
+    requires (_S_count<_Tp> == 1)
+    constexpr explicit
+    structural_variant(in_place_type_t<_Tp>, _Args&&... __args)
+        : structural_variant(
+              in_place_index<__detail::__variant::__index_of_v<_Tp, _Types...>>,
+              std::forward<_Args>(__args)...)
+    { }
+
+    // Converts from exactly one of the alternative types.
+    template<typename _Tp>
+    requires (_S_count<__remove_cvref_t<_Tp>> == 1)
+    constexpr
+    structural_variant(_Tp&& __t)
+        : structural_variant(in_place_type<__remove_cvref_t<_Tp>>,
+                             std::forward<_Tp>(__t))
+    { }
+
+    constexpr
+    structural_variant(const variant<_Types...>& __v)
+        : structural_variant(_S_from<0>(__v))
+    { }
+
+    constexpr
+    operator variant<_Types...>() const
+    {
+        return _M_to_variant<0>();
+    }
+
+    constexpr size_t index() const noexcept { return _M_index; }
+
+    constexpr bool valueless_by_exception() const noexcept { return false; }
+
+    template<typename _Visitor>
+    constexpr decltype(auto)
+    visit(_Visitor&& __vis) const
+    {
+        using _Res = invoke_result_t<_Visitor&, const _Alt<0>&>;
+        return _M_visit<0, _Res>(__vis);
+    }
+
+    friend constexpr bool
+    operator==(const structural_variant& __lhs,
+               const structural_variant& __rhs)
+    {
+        if (__lhs._M_index != __rhs._M_index) {
+            return false;
+        }
+        return __lhs._M_equal<0>(__rhs);
+    }
+
+    __detail::__structural::_Union<_Types...> _M_u;
+    __index_type _M_index;
+};
+
+template<typename _Tp, typename... _Types>
+constexpr bool
+holds_alternative(const structural_variant<_Types...>& __v) noexcept
+{
+    static_assert((is_same_v<_Tp, _Types> + ...) == 1,
+                  "T must occur exactly once in alternatives");
+    return __v.index() == __detail::__variant::__index_of_v<_Tp, _Types...>;
+}
+
+template<size_t _Np, typename... _Types>
+constexpr const typename __detail::__variant::_Nth_type<_Np, _Types...>::type&
+get(const structural_variant<_Types...>& __v)
+{
+    static_assert(_Np < sizeof...(_Types),
+                  "The index must be in [0, number of alternatives)");
+    if (__v.index() != _Np) {
+        __throw_bad_variant_access(false);
+    }
+    return __detail::__structural::__get<_Np>(__v._M_u);
+}
+
+template<typename _Tp, typename... _Types>
+constexpr const _Tp&
+get(const structural_variant<_Types...>& __v)
+{
+    static_assert((is_same_v<_Tp, _Types> + ...) == 1,
+                  "T must occur exactly once in alternatives");
+    return std::get<__detail::__variant::__index_of_v<_Tp, _Types...>>(__v);
+}
+
+template<size_t _Np, typename... _Types>
+constexpr const typename __detail::__variant::_Nth_type<_Np, _Types...>::type*
+get_if(const structural_variant<_Types...>* __ptr) noexcept
+{
+    static_assert(_Np < sizeof...(_Types),
+                  "The index must be in [0, number of alternatives)");
+    if (__ptr && __ptr->index() == _Np) {
+        return std::__addressof(__detail::__structural::__get<_Np>(__ptr->_M_u));
+    }
+    return nullptr;
+}
+
+template<typename _Tp, typename... _Types>
+constexpr const _Tp*
+get_if(const structural_variant<_Types...>* __ptr) noexcept
+{
+    static_assert((is_same_v<_Tp, _Types> + ...) == 1,
+                  "T must occur exactly once in alternatives");
+    return std::get_if<__detail::__variant::__index_of_v<_Tp, _Types...>>(
+               __ptr);
+}
+
+template<typename _Visitor, typename... _Types>
+constexpr decltype(auto)
+visit(_Visitor&& __visitor, const structural_variant<_Types...>& __v)
+{
+    return __v.visit(std::forward<_Visitor>(__visitor));
+}
+
+template<typename _Visitor, typename... _Types>
+constexpr decltype(auto)
+visit(_Visitor&& __visitor, structural_variant<_Types...>& __v)
+{
+    return __v.visit(std::forward<_Visitor>(__visitor));
+}
+
+template<typename... _Types>
+struct variant_size<structural_variant<_Types...>>
+    : std::integral_constant<size_t, sizeof...(_Types)> {};
+
+template<size_t _Np, typename... _Types>
+struct variant_alternative<_Np, structural_variant<_Types...>> {
+    static_assert(_Np < sizeof...(_Types),
+                  "The index must be in [0, number of alternatives)");
+
+    using type = typename __detail::__variant::_Nth_type<_Np, _Types...>::type;
+};
+
+_GLIBCXX_END_NAMESPACE_VERSION
+} // namespace std
+
+#endif // C++20
+
+#endif // _GLIBCXX_STRUCTURAL_OPTIONAL_VARIANT
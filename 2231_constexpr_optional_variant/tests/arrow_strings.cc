@@ -0,0 +1,50 @@
+// Export and import of optional strings through the Arrow C data interface,
+// including engaged empty strings, which must stay valid and distinct from
+// nulls. An engaged string_view{} has a null data pointer, so run this
+// under -fsanitize=undefined as well: no null may reach memcpy.
+//
+//   g++ -std=c++20 -O2 -I.. arrow_strings.cc && ./a.out
+//   g++ -std=c++20 -g -fsanitize=address,undefined
+//       -fno-sanitize-recover -I.. arrow_strings.cc && ./a.out
+
+#include <cassert>
+#include <vector>
+#include "arrow_optional_variant.h"
+
+template<typename _Tp>
+void
+round_trip(const std::vector<std::optional<_Tp>>& __in)
+{
+    ArrowArray __a;
+    ArrowSchema __s;
+    std::export_optional_array(std::span<const std::optional<_Tp>>(__in),
+                               &__a, &__s);
+    {
+        std::arrow_optional_array<_Tp> __out(__a, __s);
+        assert(__out.size() == __in.size());
+        for (size_t __i = 0; __i < __in.size(); ++__i) {
+            assert(__out.has_value(__i) == __in[__i].has_value());
+            if (__in[__i]) {
+                assert(*__out[__i] == *__in[__i]);
+            }
+        }
+    }
+    __a.release(&__a);
+    __s.release(&__s);
+}
+
+int
+main()
+{
+    using std::nullopt;
+    using std::string;
+    using std::string_view;
+
+    // Only empty strings: the data buffer holds no bytes at all.
+    round_trip<string_view>({ string_view{}, string_view{} });
+    round_trip<string_view>({ string_view{}, nullopt, string_view("") });
+    round_trip<string_view>({ "abc", string_view{}, nullopt, "", "de" });
+    round_trip<string>({ string(), nullopt, "xyz", string() });
+    round_trip<string_view>({});
+    return 0;
+}
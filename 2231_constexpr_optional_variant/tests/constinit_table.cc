@@ -0,0 +1,63 @@
+// Constant initialization of variants and optionals whose alternatives have
+// non-trivial destructors, as in static dispatch tables. constinit makes
+// the compiler reject any of them that would need a dynamic initializer.
+//
+//   g++ -std=c++20 -O2 -I.. constinit_table.cc && ./a.out
+
+#include "fixed_optional.h"
+#include "fixed_variant.h"
+
+// Not a literal type: the destructor is user-provided and not constexpr.
+struct Handler {
+    const char* name;
+    int (*fn)(int);
+
+    constexpr Handler(const char* __n, int (*__f)(int))
+        : name(__n), fn(__f)
+    { }
+
+    ~Handler() { }
+};
+
+static_assert(!std::is_trivially_destructible_v<Handler>);
+
+int twice(int __i) { return 2 * __i; }
+int negate(int __i) { return -__i; }
+
+using Entry = std::variant<int, Handler>;
+
+// Constructed in place: a Handler temporary would not be a constant.
+constexpr std::in_place_type_t<Handler> handler;
+
+constinit Entry table[] = {
+    Entry(handler, "twice", &twice), 7, Entry(handler, "negate", &negate), 42,
+};
+
+constinit std::optional<Handler> fallback(std::in_place, "negate", &negate);
+
+constinit std::variant<std::monostate, Handler> empty_slot;
+
+int
+call(const Entry& __e, int __arg)
+{
+    if (auto __h = std::get_if<Handler>(&__e)) {
+        return __h->fn(__arg);
+    }
+    return std::get<int>(__e);
+}
+
+int
+main()
+{
+    if (call(table[0], 5) != 10 || call(table[1], 5) != 7
+        || call(table[2], 5) != -5 || call(table[3], 5) != 42
+        || std::get<Handler>(table[2]).name[0] != 'n') {
+        return 1;
+    }
+    if (!fallback || fallback->fn(3) != -3 || empty_slot.index() != 0) {
+        return 1;
+    }
+    // Assignment still works on a constant-initialized object.
+    table[1].emplace<Handler>("twice", &twice);
+    return call(table[1], 4) == 8 ? 0 : 1;
+}
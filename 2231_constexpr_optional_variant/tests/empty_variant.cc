@@ -0,0 +1,87 @@
+// Layout, comparison and code generation of variants whose alternatives
+// are all empty and trivial.
+//
+//   g++ -std=c++20 -O2 -I.. empty_variant.cc && ./a.out
+//   tests/empty_variant.sh      compares the code with an enum class
+
+#include <cassert>
+#include "fixed_variant.h"
+
+// Tags with defaulted comparisons, opted in to index-only comparison.
+struct A { auto operator<=>(const A&) const = default; };
+struct B { auto operator<=>(const B&) const = default; };
+struct C { auto operator<=>(const C&) const = default; };
+
+template<> inline constexpr bool std::enable_variant_index_compare<A> = true;
+template<> inline constexpr bool std::enable_variant_index_compare<B> = true;
+template<> inline constexpr bool std::enable_variant_index_compare<C> = true;
+
+// Empty, but never equal to itself.
+struct W { bool operator==(const W&) const { return false; } };
+
+using V = std::variant<std::monostate, A, B, C>;
+enum class E : unsigned char { m, a, b, c };
+
+static_assert(sizeof(V) == 1 && alignof(V) == 1);
+static_assert(sizeof(std::variant<std::monostate>) == 1);
+static_assert(sizeof(std::variant<W>) == 1);
+static_assert(std::is_trivially_copyable_v<V>);
+static_assert(std::is_trivially_destructible_v<V>);
+static_assert(sizeof(std::variant<std::monostate, int>) == 2 * sizeof(int));
+
+static_assert(V(B{}) == V(B{}) && V(A{}) != V(B{}));
+static_assert(V(A{}) < V(B{}) && V(C{}) >= V(B{}));
+static_assert((V(A{}) <=> V(B{})) < 0);
+static_assert(std::visit([](auto __x) { return sizeof(__x); }, V(C{})) == 1);
+
+// The functions compared by empty_variant.sh: each variant function must
+// compile to the same instructions as its enum class counterpart.
+extern "C" {
+int
+visit_variant(const V& __v)
+{
+    struct _Vis {
+        int operator()(std::monostate) const { return 17; }
+        int operator()(A) const { return 4; }
+        int operator()(B) const { return 99; }
+        int operator()(C) const { return 31; }
+    };
+    return std::visit(_Vis{}, __v);
+}
+
+int
+visit_enum(const E& __e)
+{
+    switch (__e) {
+    case E::m: return 17;
+    case E::a: return 4;
+    case E::b: return 99;
+    case E::c: return 31;
+    }
+    __builtin_unreachable();
+}
+
+bool eq_variant(const V& __v, const V& __w) { return __v == __w; }
+
+bool eq_enum(const E& __e, const E& __f) { return __e == __f; }
+
+bool lt_variant(const V& __v, const V& __w) { return __v < __w; }
+
+bool lt_enum(const E& __e, const E& __f) { return __e < __f; }
+}
+
+int
+main()
+{
+    V __v = B{}, __w = C{};
+    assert(__v != __w && __v < __w && __v == __v);
+    assert(visit_variant(__v) == 99 && visit_variant(V{}) == 17);
+    assert(eq_variant(__w, V(C{})) && lt_variant(V(A{}), __v));
+
+    // W is empty and trivial but not opted in: its own operator== decides.
+    std::variant<W> __x;
+    assert(!(__x == __x));
+    assert(__x != __x);
+    assert((std::variant<W, A>(A{}) == std::variant<W, A>(A{})));
+    return 0;
+}
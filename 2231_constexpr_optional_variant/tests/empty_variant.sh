@@ -0,0 +1,36 @@
+#!/bin/sh
+# Checks that each *_variant function in empty_variant.cc compiles to the
+# same instructions as its *_enum counterpart, with local labels and the
+# names of jump tables normalized.
+#
+#   tests/empty_variant.sh [g++ options...]
+
+cd "$(dirname "$0")" || exit 1
+CXX=${CXX:-g++}
+asm=$(mktemp) || exit 1
+trap 'rm -f "$asm"' EXIT
+
+$CXX -std=c++20 -O2 "$@" -S -I.. -o "$asm" empty_variant.cc || exit 1
+
+body() {
+    awk -v f="$1" '
+        $0 == f ":" { on = 1; next }
+        on && /\.cfi_endproc/ { exit }
+        on && !/^\t\.(cfi|p2align|align)/ {
+            gsub(/\.L[A-Za-z0-9_]+/, "L"); gsub(/CSWTCH\.[0-9]+/, "CSWTCH"); print
+        }' "$asm"
+}
+
+status=0
+for f in visit eq lt; do
+    if [ -z "$(body ${f}_enum)" ]; then
+        echo "$f: no code found"; status=1
+    elif [ "$(body ${f}_variant)" = "$(body ${f}_enum)" ]; then
+        echo "$f: same code as enum class"
+    else
+        echo "$f: differs from enum class"; status=1
+        body ${f}_variant > "$asm.v"; body ${f}_enum > "$asm.e"
+        diff "$asm.v" "$asm.e"; rm -f "$asm.v" "$asm.e"
+    fi
+done
+exit $status
@@ -0,0 +1,94 @@
+// Kernels instantiated on structural_variant and structural_optional
+// template arguments.
+//
+// The configuration is a template argument, so visiting it selects the
+// alternative at compile time: the results are checked by static_assert,
+// and each *_structural function must compile to the same instructions as
+// its *_direct counterpart, which applies the alternative by hand.
+//
+//   g++ -std=c++20 -O2 -I.. structural_kernel.cc && ./a.out
+//   tests/structural_kernel.sh      compares the code with the direct forms
+
+#include <cassert>
+#include "structural_optional_variant.h"
+
+struct Linear {
+    int slope, offset;
+
+    constexpr int operator()(int __x) const { return slope * __x + offset; }
+};
+
+struct Exponential {
+    int base;
+
+    constexpr int
+    operator()(int __x) const
+    {
+        int __r = 1;
+        for (int __i = 0; __i < __x; ++__i) {
+            __r *= base;
+        }
+        return __r;
+    }
+};
+
+using Model = std::structural_variant<Linear, Exponential>;
+
+template<Model _Cfg>
+constexpr int
+kernel(int __x)
+{
+    return std::visit([__x](const auto& __m) { return __m(__x); }, _Cfg);
+}
+
+template<std::structural_optional<int> _Scale>
+constexpr int
+scale(int __x)
+{
+    return __x * _Scale.value_or(1);
+}
+
+static_assert(kernel<Linear{3, 4}>(2) == 10);
+static_assert(kernel<Exponential{3}>(4) == 81);
+static_assert(kernel<Model(std::in_place_index<1>, 2)>(10) == 1024);
+static_assert(scale<5>(7) == 35 && scale<std::nullopt>(7) == 7);
+
+// Equal configurations name the same specialization; different values, or
+// the same value in another alternative, do not.
+static_assert(&kernel<Linear{3, 4}> == &kernel<Model(Linear{3, 4})>);
+static_assert(&kernel<Linear{3, 4}> != &kernel<Linear{3, 5}>);
+
+using Twice = std::structural_variant<Linear, Linear>;
+
+template<Twice _Cfg>
+constexpr size_t
+which()
+{
+    return _Cfg.index();
+}
+
+static_assert(which<Twice(std::in_place_index<0>, 1, 2)>() == 0);
+static_assert(which<Twice(std::in_place_index<1>, 1, 2)>() == 1);
+
+// The functions compared by structural_kernel.sh.
+extern "C" {
+int linear_structural(int __x) { return kernel<Linear{3, 4}>(__x); }
+
+int linear_direct(int __x) { return 3 * __x + 4; }
+
+int exponential_structural(int __x) { return kernel<Exponential{3}>(__x); }
+
+int exponential_direct(int __x) { return Exponential{3}(__x); }
+
+int scale_structural(int __x) { return scale<5>(__x); }
+
+int scale_direct(int __x) { return __x * 5; }
+}
+
+int
+main()
+{
+    assert(linear_structural(5) == 19 && exponential_structural(3) == 27);
+    assert(scale_structural(3) == 15 && scale<std::nullopt>(3) == 3);
+    return 0;
+}
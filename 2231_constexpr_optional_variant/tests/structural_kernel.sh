@@ -0,0 +1,36 @@
+#!/bin/sh
+# Checks that each *_structural function in structural_kernel.cc compiles
+# to the same instructions as its *_direct counterpart, that is, that no
+# branch on the structural template argument is left at run time.
+#
+#   tests/structural_kernel.sh [g++ options...]
+
+cd "$(dirname "$0")" || exit 1
+CXX=${CXX:-g++}
+asm=$(mktemp) || exit 1
+trap 'rm -f "$asm"' EXIT
+
+$CXX -std=c++20 -O2 "$@" -S -I.. -o "$asm" structural_kernel.cc || exit 1
+
+body() {
+    awk -v f="$1" '
+        $0 == f ":" { on = 1; next }
+        on && /\.cfi_endproc/ { exit }
+        on && !/^\t\.(cfi|p2align|align)/ {
+            gsub(/\.L[A-Za-z0-9_]+/, "L"); print
+        }' "$asm"
+}
+
+status=0
+for f in linear exponential scale; do
+    if [ -z "$(body ${f}_direct)" ]; then
+        echo "$f: no code found"; status=1
+    elif [ "$(body ${f}_structural)" = "$(body ${f}_direct)" ]; then
+        echo "$f: same code as direct"
+    else
+        echo "$f: differs from direct"; status=1
+        body ${f}_structural > "$asm.s"; body ${f}_direct > "$asm.d"
+        diff "$asm.s" "$asm.d"; rm -f "$asm.s" "$asm.d"
+    fi
+done
+exit $status
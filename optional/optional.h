@@ -1,443 +1,1041 @@
-template<typename _Tp>
-class optional;
-
-template<typename _Tp, typename _Up>
-using __converts_from_optional =
-    __or_<is_constructible<_Tp, const optional<_Up>&>,
-    is_constructible<_Tp, optional<_Up>&>,
-    is_constructible<_Tp, const optional<_Up>&&>,
-    is_constructible<_Tp, optional<_Up>&&>,
-    is_convertible<const optional<_Up>&, _Tp>,
-    is_convertible<optional<_Up>&, _Tp>,
-    is_convertible<const optional<_Up>&&, _Tp>,
-    is_convertible<optional<_Up>&&, _Tp>>;
-
-template<typename _Tp, typename _Up>
-using __assigns_from_optional =
-    __or_<is_assignable<_Tp&, const optional<_Up>&>,
-    is_assignable<_Tp&, optional<_Up>&>,
-    is_assignable<_Tp&, const optional<_Up>&&>,
-    is_assignable<_Tp&, optional<_Up>&&>>;
-
-/**
-  * @brief Class template for optional values.
-  */
-template<typename _Tp>
-class optional
-{
-    static_assert(!is_same_v<remove_cv_t<_Tp>, nullopt_t>);
-    static_assert(!is_same_v<remove_cv_t<_Tp>, in_place_t>);
-    static_assert(!is_reference_v<_Tp>);
-
-private:
-    using _Stored_type = remove_const_t<_Tp>;
-    struct _Empty_byte { };
-    union {
-        _Empty_byte _M_empty;
-        _Stored_type _M_payload;
-    };
-    bool _M_engaged;
-
-    template<typename... _Args>
-    void _M_construct(_Args&&... __args)
-    noexcept(is_nothrow_constructible<_Stored_type, _Args...>())
-    {
-        ::new ((void *) std::__addressof(this->_M_payload))
-        _Stored_type(std::forward<_Args>(__args)...);
-        this->_M_engaged = true;
-    }
-
-public:
-    using value_type = _Tp;
-
-    constexpr optional()
-        : _M_empty(), _M_engaged(false) {}
-
-    constexpr optional(nullopt_t) noexcept
-        : _M_empty(), _M_engaged(false) {}
-
-    constexpr optional(optional const&)
-    requires is_trivially_copy_constructible_v<_Tp> &&
-    is_copy_constructible_v<_Tp> = default;
-    constexpr optional(optional const& rhs)
-    requires is_copy_constructible_v<_Tp> {
-        if (rhs._M_engaged)
-        {
-            _M_construct(rhs._M_payload);
-        }
-    }
-
-    constexpr optional(optional&&)
-    requires is_trivially_move_constructible_v<_Tp> &&
-    is_move_constructible_v<_Tp> = default;
-    constexpr optional(optional&& rhs)
-    noexcept(is_nothrow_move_constructible<_Tp>)
-    requires is_move_constructible_v<_Tp> {
-        if (rhs._M_engaged)
-        {
-            _M_construct(std::move(rhs._M_payload));
-        }
-    }
-
-    optional& operator=(optional const&)
-    requires is_copy_constructible_v<_Tp> && is_copy_assignable_v<_Tp>
-    && is_trivially_copy_assignable<_Tp> = default;
-    optional& operator=(optional const& rhs)
-    requires is_copy_constructible_v<_Tp> && is_copy_assignable_v<_Tp> {
-        if (_M_engaged && rhs._M_engaged)
-        {
-            _M_payload = rhs._M_payload;
-        } else if (rhs._M_engaged)
-        {
-            _M_construct(rhs._M_payload);
-        } else
-        {
-            reset();
-        }
-        return *this;
-    }
-
-    optional& operator=(optional&&)
-    requires is_move_constructible_v<_Tp> && is_move_assignable_v<_Tp>
-    && is_trivially_move_assignable = default;
-    optional& operator=(optional&& rhs)
-    requires is_move_constructible_v<_Tp> && is_move_assignable_v<_Tp>
-    noexcept(__and_<is_nothrow_move_constructible<_Tp>,
-             is_nothrow_move_assignable<_Tp>>())
-    {
-        if (_M_engaged && rhs._M_engaged) {
-            _M_payload = std::move(rhs._M_payload);
-        } else if (rhs._M_engaged) {
-            _M_construct(std::move(rhs._M_payload));
-        } else {
-            reset();
-        }
-        return *this;
-    }
-
-    // Destructor
-    ~optional() requires is_trivially_destructible_v<_Tp> = default;
-    ~optional()
-    {
-        if (_M_engaged) {
-            _M_payload.~_Stored_type();
-        }
-    }
-
-    // Converting constructors for engaged optionals.
-    template <typename _Up = _Tp,
-              enable_if_t<__and_<
-                              __not_<is_same<optional<_Tp>, decay_t<_Up>>>,
-                                      __not_<is_same<in_place_t, decay_t<_Up>>>,
-                                              is_constructible<_Tp, _Up&&>
-                                              >::value, bool> = false>
-                                     explicit(!is_convertible_v<_Up&&, _Tp>)
-                                     constexpr optional(_Up&& __t)
-                                         : optional(std::in_place, std::forward<_Up>(__t)) { }
-
-    template <typename _Up,
-              enable_if_t<__and_<
-                              __not_<is_same<_Tp, _Up>>,
-                              is_constructible<_Tp, const _Up&>,
-                              __not_<__converts_from_optional<_Tp, _Up>>
-                              >::value, bool> = false>
-    explicit(!is_convertible_v<_Up const&, _Tp>)
-    constexpr optional(const optional<_Up>& __t)
-    {
-        if (__t) {
-            emplace(*__t);
-        }
-    }
-
-    template <typename _Up,
-              enable_if_t<__and_<
-                              __not_<is_same<_Tp, _Up>>,
-                              is_constructible<_Tp, _Up&&>,
-                              __not_<__converts_from_optional<_Tp, _Up>>
-                              >::value, bool> = false>
-    explicit(!is_convertible_v<_Up&&, _Tp>)
-    constexpr optional(optional<_Up>&& __t)
-    {
-        if (__t) {
-            emplace(std::move(*__t));
-        }
-    }
-
-    template<typename... _Args,
-             enable_if_t<is_constructible_v<_Tp, _Args&&...>, bool> = false>
-    explicit constexpr optional(in_place_t, _Args&&... __args)
-        : _M_payload(std::forward<_Args>(__args)...), _M_engaged(true) { }
-
-    template<typename _Up, typename... _Args,
-             enable_if_t<is_constructible_v<_Tp,
-                                            initializer_list<_Up>&,
-                                            _Args&&...>, bool> = false>
-    explicit constexpr optional(in_place_t,
-                                initializer_list<_Up> __il,
-                                _Args&&... __args)
-        : _M_payload(__il, std::forward<_Args>(__args)...), _M_engaged(true) { }
-
-    // Assignment operators.
-    optional&
-    operator=(nullopt_t) noexcept
-    {
-        reset();
-        return *this;
-    }
-
-    template<typename _Up = _Tp>
-    enable_if_t<__and_<
-                    __not_<is_same<optional<_Tp>, decay_t<_Up>>>,
-                                   is_constructible<_Tp, _Up>,
-                                   __not_<__and_<is_scalar<_Tp>,
-                                           is_same<_Tp, decay_t<_Up>>>>,
-                                           is_assignable<_Tp&, _Up>>::value,
-                                          optional&>
-                                   operator=(_Up&& __u)
-    {
-        if (_M_engaged) {
-            _M_payload = std::forward<_Up>(__u);
-        } else {
-            _M_construct(std::forward<_Up>(__u));
-        }
-
-        return *this;
-    }
-
-    template<typename _Up>
-    enable_if_t<__and_<
-                    __not_<is_same<_Tp, _Up>>,
-                    is_constructible<_Tp, const _Up&>,
-                    is_assignable<_Tp&, _Up>,
-                    __not_<__converts_from_optional<_Tp, _Up>>,
-                    __not_<__assigns_from_optional<_Tp, _Up>>
-                    >::value,
-                optional&>
-    operator=(const optional<_Up>& __u)
-    {
-        if (__u) {
-            if (_M_engaged) {
-                _M_payload = *__u;
-            } else {
-                _M_construct(*__u);
-            }
-        } else {
-            reset();
-        }
-        return *this;
-    }
-
-    template<typename _Up>
-    enable_if_t<__and_<
-                    __not_<is_same<_Tp, _Up>>,
-                    is_constructible<_Tp, _Up>,
-                    is_assignable<_Tp&, _Up>,
-                    __not_<__converts_from_optional<_Tp, _Up>>,
-                    __not_<__assigns_from_optional<_Tp, _Up>>
-                    >::value,
-                optional&>
-    operator=(optional<_Up>&& __u)
-    {
-        if (__u) {
-            if (_M_engaged) {
-                _M_payload = std::move(*__u);
-            } else {
-                _M_construct(std::move(*__u));
-            }
-        } else {
-            reset();
-        }
-
-        return *this;
-    }
-
-    template<typename... _Args>
-    enable_if_t<is_constructible<_Tp, _Args&&...>::value, _Tp&>
-    emplace(_Args&&... __args)
-    {
-        reset();
-        _M_construct(std::forward<_Args>(__args)...);
-        return _M_payload;
-    }
-
-    template<typename _Up, typename... _Args>
-    enable_if_t<is_constructible<_Tp, initializer_list<_Up>&,
-                                 _Args&&...>::value, _Tp&>
-    emplace(initializer_list<_Up> __il, _Args&&... __args)
-    {
-        reset();
-        _M_construct(__il, std::forward<_Args>(__args)...);
-        return _M_payload;
-    }
-
-    // Destructor is implicit, implemented in _Optional_base.
-
-    // Swap.
-    void
-    swap(optional& __other)
-    noexcept(is_nothrow_move_constructible<_Tp>()
-             && is_nothrow_swappable_v<_Tp>)
-    {
-        using std::swap;
-
-        if (_M_engaged && __other._M_is_engaged()) {
-            swap(_M_payload, __other._M_get());
-        } else if (_M_engaged) {
-            __other._M_construct(std::move(_M_payload));
-            this->_M_destruct();
-        } else if (__other._M_is_engaged()) {
-            this->_M_construct(std::move(__other._M_get()));
-            __other._M_destruct();
-        }
-    }
-
-    // Observers.
-    template <typename _Self>
-    constexpr auto operator->(_Self&& this)
-    {
-        return std::__addressof(std::forward_like<_Self>(_M_payload);
-    }
-
-    template <typename _Self>
-    constexpr auto&& operator*(_Self&& this)
-    {
-        __glibcxx_assert(_M_engaged);
-        return std::forward_like<_Self>(_M_payload);
-    }
-
-    constexpr explicit operator bool() const noexcept
-    {
-        return _M_engaged;
-    }
-
-    constexpr bool has_value() const noexcept
-    {
-        return _M_engaged;
-    }
-
-    template <typename _Self>
-    constexpr auto&& value(_Self&& this)
-    {
-        return _M_engaged
-        ? std::forward_like<_Self>(_M_payload)
-        : (__throw_bad_optional_access(),
-           std::forward_like<_Self>(_M_payload));
-    }
-
-    template <typename _Self, typename _Up>
-    constexpr _Tp
-    value_or(_Self&& this, _Up&& __u) const&
-    {
-        static_assert(is_constructible_v<_Tp, std::like_t<Self, _Tp>>);
-        static_assert(is_convertible_v<_Up&&, _Tp>);
-
-        return _M_engaged
-               ? std::forward_like<_Self>(_M_payload)
-               : static_cast<_Tp>(std::forward<_Up>(__u));
-    }
-
-    void reset() noexcept
-    {
-        if (_M_engaged) {
-            _M_payload.~_Stored_type();
-            _M_engaged = false;
-        }
-    }
-
-    template <typename U>
-    constexpr auto operator<=>(optional<U> const& rhs) const
-    -> decltype(compare_3way(**this, *rhs))
-    {
-        return has_value() && rhs.has_value()
-        ? compare_3way(**this, *rhs)
-        : has_value() <=> rhs.has_value();
-    }
-
-    template <typename U>
-    constexpr auto operator<=>(U const& rhs) const
-    -> decltype(compare_3way(**this, rhs))
-    {
-        return has_value()
-        ? compare_3way(**this, rhs)
-        : strong_ordering::less;
-    }
-
-    constexpr strong_ordering operator<=>(nullopt_t ) const
-    {
-        return has_value() ? strong_ordering::greater : strong_ordering::equal;
-    }
-};
-
-// Swap and creation functions.
-
-// _GLIBCXX_RESOLVE_LIB_DEFECTS
-// 2748. swappable traits for optionals
-template<typename _Tp>
-inline enable_if_t<is_move_constructible_v<_Tp> && is_swappable_v<_Tp>>
-swap(optional<_Tp>& __lhs, optional<_Tp>& __rhs)
-noexcept(noexcept(__lhs.swap(__rhs)))
-{
-    __lhs.swap(__rhs);
-}
-
-template<typename _Tp>
-enable_if_t<!(is_move_constructible_v<_Tp> && is_swappable_v<_Tp>)>
-swap(optional<_Tp>&, optional<_Tp>&) = delete;
-
-template<typename _Tp>
-constexpr optional<decay_t<_Tp>>
-make_optional(_Tp&& __t)
-{
-    return optional<decay_t<_Tp>> { std::forward<_Tp>(__t) };
-}
-
-template<typename _Tp, typename ..._Args>
-constexpr optional<_Tp>
-make_optional(_Args&&... __args)
-{
-    return optional<_Tp> { in_place, std::forward<_Args>(__args)... };
-}
-
-template<typename _Tp, typename _Up, typename ..._Args>
-constexpr optional<_Tp>
-make_optional(initializer_list<_Up> __il, _Args&&... __args)
-{
-    return optional<_Tp> { in_place, __il, std::forward<_Args>(__args)... };
-}
-
-// Hash.
-
-template<typename _Tp, typename _Up = remove_const_t<_Tp>,
-         bool = __poison_hash<_Up>::__enable_hash_call>
-struct __optional_hash_call_base {
-    size_t
-    operator()(const optional<_Tp>& __t) const
-    noexcept(noexcept(hash<_Up> {}(*__t)))
-    {
-        // We pick an arbitrary hash for disengaged optionals which hopefully
-        // usual values of _Tp won't typically hash to.
-        constexpr size_t __magic_disengaged_hash = static_cast<size_t>(-3333);
-        return __t ? hash<_Up> {}(*__t) : __magic_disengaged_hash;
-    }
-};
-
-template<typename _Tp, typename _Up>
-struct __optional_hash_call_base<_Tp, _Up, false> {};
-
-template<typename _Tp>
-struct hash<optional<_Tp>>
-: private __poison_hash<remove_const_t<_Tp>>,
-public __optional_hash_call_base<_Tp> {
-    using result_type [[__deprecated__]] = size_t;
-    using argument_type [[__deprecated__]] = optional<_Tp>;
-};
-
-template<typename _Tp>
-struct __is_fast_hash<hash<optional<_Tp>>> : __is_fast_hash<hash<_Tp>> {
-};
-
-/// @}
-
-#if __cpp_deduction_guides >= 201606
-template <typename _Tp> optional(_Tp) -> optional<_Tp>;
-#endif
\ No newline at end of file
+#ifndef _GLIBCXX_OPTIONAL
+#define _GLIBCXX_OPTIONAL 1
+
+#if __cplusplus > 201703L
+
+#include <utility>
+#include <type_traits>
+#include <exception>
+#include <new>
+#include <initializer_list>
+#include <compare>
+#include <bits/exception_defines.h>
+#include <bits/functional_hash.h>
+#include <bits/stl_construct.h>
+#include <bits/invoke.h>
+
+// An optional in a single class template, for comparison with the layered
+// implementation in fixed_optional.h. It declares the same interface under
+// the same include guard, so either header can stand in for the other.
+//
+// Special members are conditionally trivial through requires-clauses on a
+// defaulted and a user-provided declaration each, instead of a tree of
+// payload and base specializations. With explicit object parameters the
+// observers and monadic operations are one template each rather than one
+// overload per value category; without them they fall back to the usual
+// ref-qualified overload sets.
+#if __cpp_explicit_this_parameter >= 202110L \
+    && __cpp_lib_forward_like >= 202207L
+# define _GLIBCXX_OPTIONAL_DEDUCING_THIS 1
+#endif
+
+namespace std _GLIBCXX_VISIBILITY(default)
+{
+_GLIBCXX_BEGIN_NAMESPACE_VERSION
+
+/**
+ *  @addtogroup utilities
+ *  @{
+ */
+
+#define __cpp_lib_optional 201606L
+
+template<typename _Tp>
+class optional;
+
+/// Tag type to disengage optional objects.
+struct nullopt_t {
+    // Do not user-declare default constructor at all for
+    // optional_value = {} syntax to work.
+    // nullopt_t() = delete;
+
+    // Used for constructing nullopt.
+    enum class _Construct { _Token };
+
+    // Must be constexpr for nullopt_t to be literal.
+    explicit constexpr nullopt_t(_Construct) { }
+};
+
+/// Tag to disengage optional objects.
+inline constexpr nullopt_t nullopt { nullopt_t::_Construct::_Token };
+
+/**
+ *  @brief Exception class thrown when a disengaged optional object is
+ *  dereferenced.
+ *  @ingroup exceptions
+ */
+class bad_optional_access : public exception
+{
+public:
+    bad_optional_access() { }
+
+    virtual const char* what() const noexcept override
+    {
+        return "bad optional access";
+    }
+
+    virtual ~bad_optional_access() noexcept = default;
+};
+
+void
+__throw_bad_optional_access()
+__attribute__((__noreturn__));
+
+// XXX Does not belong here.
+inline void
+__throw_bad_optional_access() {
+    _GLIBCXX_THROW_OR_ABORT(bad_optional_access());
+}
+
+// Wraps the callable used by transform so that the contained value can be
+// initialized directly from the result of invoking it.
+template<typename _Fn>
+struct _Optional_func {
+    _Fn& _M_f;
+};
+
+// The storage of fixed_optional.h, for once_optional and
+// recycling_optional, which build on either header. optional itself keeps
+// its value in an anonymous union.
+template<typename _Up, bool = is_trivially_destructible_v<_Up>>
+union _Optional_storage {
+    constexpr _Optional_storage() noexcept : _M_empty() { }
+
+    template<typename... _Args>
+    constexpr
+    _Optional_storage(in_place_t, _Args&&... __args)
+        : _M_value(std::forward<_Args>(__args)...)
+    { }
+
+    template<typename _Vp, typename... _Args>
+    constexpr
+    _Optional_storage(std::initializer_list<_Vp> __il, _Args&&... __args)
+        : _M_value(__il, std::forward<_Args>(__args)...)
+    { }
+
+    template<typename _Fn, typename... _Args>
+    constexpr
+    _Optional_storage(_Optional_func<_Fn> __f, _Args&&... __args)
+        : _M_value(std::__invoke(std::forward<_Fn>(__f._M_f),
+                                 std::forward<_Args>(__args)...))
+    { }
+
+    struct _Empty_byte { } _M_empty;
+    _Up _M_value;
+};
+
+template<typename _Up>
+union _Optional_storage<_Up, false> {
+    constexpr _Optional_storage() noexcept : _M_empty() { }
+
+    template<typename... _Args>
+    constexpr
+    _Optional_storage(in_place_t, _Args&&... __args)
+        : _M_value(std::forward<_Args>(__args)...)
+    { }
+
+    template<typename _Vp, typename... _Args>
+    constexpr
+    _Optional_storage(std::initializer_list<_Vp> __il, _Args&&... __args)
+        : _M_value(__il, std::forward<_Args>(__args)...)
+    { }
+
+    template<typename _Fn, typename... _Args>
+    constexpr
+    _Optional_storage(_Optional_func<_Fn> __f, _Args&&... __args)
+        : _M_value(std::__invoke(std::forward<_Fn>(__f._M_f),
+                                 std::forward<_Args>(__args)...))
+    { }
+
+    // User-provided destructor is needed when _Up has non-trivial dtor.
+    constexpr ~_Optional_storage() { }
+
+    struct _Empty_byte { } _M_empty;
+    _Up _M_value;
+};
+
+template<typename _Tp, typename _Up>
+using __converts_from_optional =
+    __or_<is_constructible<_Tp, const optional<_Up>&>,
+    is_constructible<_Tp, optional<_Up>&>,
+    is_constructible<_Tp, const optional<_Up>&&>,
+    is_constructible<_Tp, optional<_Up>&&>,
+    is_convertible<const optional<_Up>&, _Tp>,
+    is_convertible<optional<_Up>&, _Tp>,
+    is_convertible<const optional<_Up>&&, _Tp>,
+    is_convertible<optional<_Up>&&, _Tp>>;
+
+template<typename _Tp, typename _Up>
+using __assigns_from_optional =
+    __or_<is_assignable<_Tp&, const optional<_Up>&>,
+    is_assignable<_Tp&, optional<_Up>&>,
+    is_assignable<_Tp&, const optional<_Up>&&>,
+    is_assignable<_Tp&, optional<_Up>&&>>;
+
+template<typename _Tp>
+inline constexpr bool __is_optional_v = false;
+
+template<typename _Tp>
+inline constexpr bool __is_optional_v<optional<_Tp>> = true;
+
+/**
+  * @brief Class template for optional values.
+  */
+template<typename _Tp>
+class optional
+{
+    static_assert(!is_same_v<remove_cv_t<_Tp>, nullopt_t>);
+    static_assert(!is_same_v<remove_cv_t<_Tp>, in_place_t>);
+    static_assert(!is_reference_v<_Tp>);
+
+private:
+    template<typename _Up> friend class optional;
+
+    using _Stored_type = remove_const_t<_Tp>;
+
+    static constexpr bool _S_copy_ctor = is_copy_constructible_v<_Tp>;
+    static constexpr bool _S_move_ctor = is_move_constructible_v<_Tp>;
+    static constexpr bool _S_copy_assign =
+        _S_copy_ctor && is_copy_assignable_v<_Tp>;
+    static constexpr bool _S_move_assign =
+        _S_move_ctor && is_move_assignable_v<_Tp>;
+
+    static constexpr bool _S_trivial_dtor = is_trivially_destructible_v<_Tp>;
+    static constexpr bool _S_trivial_copy_ctor =
+        is_trivially_copy_constructible_v<_Tp>;
+    static constexpr bool _S_trivial_move_ctor =
+        is_trivially_move_constructible_v<_Tp>;
+    static constexpr bool _S_trivial_copy_assign =
+        _S_trivial_dtor && _S_trivial_copy_ctor
+        && is_trivially_copy_assignable_v<_Tp>;
+    static constexpr bool _S_trivial_move_assign =
+        _S_trivial_dtor && _S_trivial_move_ctor
+        && is_trivially_move_assignable_v<_Tp>;
+
+    struct _Empty_byte { };
+
+    union {
+        _Empty_byte _M_empty;
+        _Stored_type _M_payload;
+    };
+    bool _M_engaged;
+
+#ifdef _GLIBCXX_OPTIONAL_DEDUCING_THIS
+    // The contained value as accessed through an expression of type
+    // _Self&&. _M_payload has had the const of _Tp removed, so casting to
+    // this type puts it back.
+    template<typename _Self>
+    using __like_t = decltype(std::forward_like<_Self>(std::declval<_Tp&>()));
+#endif
+
+    // _M_construct has !_M_engaged as a precondition.
+    template<typename... _Args>
+    constexpr void
+    _M_construct(_Args&&... __args)
+    noexcept(is_nothrow_constructible_v<_Stored_type, _Args...>)
+    {
+        std::construct_at(std::__addressof(_M_payload),
+                          std::forward<_Args>(__args)...);
+        _M_engaged = true;
+    }
+
+    // _M_destruct has _M_engaged as a precondition.
+    constexpr void
+    _M_destruct() noexcept
+    {
+        _M_engaged = false;
+        _M_payload.~_Stored_type();
+    }
+
+    template<typename _Fn, typename... _Args>
+    explicit constexpr
+    optional(_Optional_func<_Fn> __f, _Args&&... __args)
+        : _M_payload(std::__invoke(std::forward<_Fn>(__f._M_f),
+                                   std::forward<_Args>(__args)...)),
+          _M_engaged(true)
+    { }
+
+public:
+    using value_type = _Tp;
+
+    constexpr optional() noexcept
+        : _M_empty(), _M_engaged(false) { }
+
+    constexpr optional(nullopt_t) noexcept
+        : _M_empty(), _M_engaged(false) { }
+
+    // Copy and move constructors.
+    optional(const optional&)
+    requires _S_trivial_copy_ctor = default;
+
+    constexpr optional(const optional& __rhs)
+    requires (_S_copy_ctor && !_S_trivial_copy_ctor)
+        : _M_empty(), _M_engaged(false)
+    {
+        if (__rhs._M_engaged) {
+            _M_construct(__rhs._M_payload);
+        }
+    }
+
+    optional(optional&&)
+    requires _S_trivial_move_ctor = default;
+
+    constexpr optional(optional&& __rhs)
+    noexcept(is_nothrow_move_constructible_v<_Tp>)
+    requires (_S_move_ctor && !_S_trivial_move_ctor)
+        : _M_empty(), _M_engaged(false)
+    {
+        if (__rhs._M_engaged) {
+            _M_construct(std::move(__rhs._M_payload));
+        }
+    }
+
+    // Converting constructors for engaged optionals.
+    template<typename _Up = _Tp>
+    requires (!is_same_v<optional, __remove_cvref_t<_Up>>
+              && !is_same_v<in_place_t, __remove_cvref_t<_Up>>
+              && is_constructible_v<_Tp, _Up&&>)
+    explicit(!is_convertible_v<_Up&&, _Tp>)
+    constexpr
+    optional(_Up&& __t)
+        : _M_payload(std::forward<_Up>(__t)), _M_engaged(true) { }
+
+    template<typename _Up>
+    requires (!is_same_v<_Tp, _Up>
+              && is_constructible_v<_Tp, const _Up&>
+              && !__converts_from_optional<_Tp, _Up>::value)
+    explicit(!is_convertible_v<const _Up&, _Tp>)
+    constexpr
+    optional(const optional<_Up>& __t)
+        : _M_empty(), _M_engaged(false)
+    {
+        if (__t._M_engaged) {
+            _M_construct(*__t);
+        }
+    }
+
+    template<typename _Up>
+    requires (!is_same_v<_Tp, _Up>
+              && is_constructible_v<_Tp, _Up&&>
+              && !__converts_from_optional<_Tp, _Up>::value)
+    explicit(!is_convertible_v<_Up&&, _Tp>)
+    constexpr
+    optional(optional<_Up>&& __t)
+        : _M_empty(), _M_engaged(false)
+    {
+        if (__t._M_engaged) {
+            _M_construct(std::move(*__t));
+        }
+    }
+
+    template<typename... _Args>
+    requires is_constructible_v<_Tp, _Args&&...>
+    explicit constexpr
+    optional(in_place_t, _Args&&... __args)
+        : _M_payload(std::forward<_Args>(__args)...), _M_engaged(true) { }
+
+    template<typename _Up, typename... _Args>
+    requires is_constructible_v<_Tp, initializer_list<_Up>&, _Args&&...>
+    explicit constexpr
+    optional(in_place_t, initializer_list<_Up> __il, _Args&&... __args)
+        : _M_payload(__il, std::forward<_Args>(__args)...), _M_engaged(true)
+    { }
+
+    // Destructor.
+    ~optional() requires _S_trivial_dtor = default;
+
+    constexpr ~optional()
+    {
+        if (_M_engaged) {
+            _M_payload.~_Stored_type();
+        }
+    }
+
+    // Assignment operators.
+    optional& operator=(const optional&)
+    requires _S_trivial_copy_assign = default;
+
+    constexpr optional&
+    operator=(const optional& __rhs)
+    requires (_S_copy_assign && !_S_trivial_copy_assign)
+    {
+        if (_M_engaged && __rhs._M_engaged) {
+            _M_payload = __rhs._M_payload;
+        } else if (__rhs._M_engaged) {
+            _M_construct(__rhs._M_payload);
+        } else {
+            reset();
+        }
+        return *this;
+    }
+
+    optional& operator=(optional&&)
+    requires _S_trivial_move_assign = default;
+
+    constexpr optional&
+    operator=(optional&& __rhs)
+    noexcept(is_nothrow_move_constructible_v<_Tp>
+             && is_nothrow_move_assignable_v<_Tp>)
+    requires (_S_move_assign && !_S_trivial_move_assign)
+    {
+        if (_M_engaged && __rhs._M_engaged) {
+            _M_payload = std::move(__rhs._M_payload);
+        } else if (__rhs._M_engaged) {
+            _M_construct(std::move(__rhs._M_payload));
+        } else {
+            reset();
+        }
+        return *this;
+    }
+
+    constexpr optional&
+    operator=(nullopt_t) noexcept
+    {
+        reset();
+        return *this;
+    }
+
+    template<typename _Up = _Tp>
+    requires (!is_same_v<optional, __remove_cvref_t<_Up>>
+              && !(is_scalar_v<_Tp> && is_same_v<_Tp, decay_t<_Up>>)
+              && is_constructible_v<_Tp, _Up>
+              && is_assignable_v<_Tp&, _Up>)
+    constexpr optional&
+    operator=(_Up&& __u)
+    {
+        if (_M_engaged) {
+            _M_payload = std::forward<_Up>(__u);
+        } else {
+            _M_construct(std::forward<_Up>(__u));
+        }
+        return *this;
+    }
+
+    template<typename _Up>
+    requires (!is_same_v<_Tp, _Up>
+              && is_constructible_v<_Tp, const _Up&>
+              && is_assignable_v<_Tp&, const _Up&>
+              && !__converts_from_optional<_Tp, _Up>::value
+              && !__assigns_from_optional<_Tp, _Up>::value)
+    constexpr optional&
+    operator=(const optional<_Up>& __u)
+    {
+        if (__u._M_engaged) {
+            if (_M_engaged) {
+                _M_payload = *__u;
+            } else {
+                _M_construct(*__u);
+            }
+        } else {
+            reset();
+        }
+        return *this;
+    }
+
+    template<typename _Up>
+    requires (!is_same_v<_Tp, _Up>
+              && is_constructible_v<_Tp, _Up>
+              && is_assignable_v<_Tp&, _Up>
+              && !__converts_from_optional<_Tp, _Up>::value
+              && !__assigns_from_optional<_Tp, _Up>::value)
+    constexpr optional&
+    operator=(optional<_Up>&& __u)
+    {
+        if (__u._M_engaged) {
+            if (_M_engaged) {
+                _M_payload = std::move(*__u);
+            } else {
+                _M_construct(std::move(*__u));
+            }
+        } else {
+            reset();
+        }
+        return *this;
+    }
+
+    template<typename... _Args>
+    requires is_constructible_v<_Tp, _Args&&...>
+    constexpr _Tp&
+    emplace(_Args&&... __args)
+    {
+        reset();
+        _M_construct(std::forward<_Args>(__args)...);
+        return _M_payload;
+    }
+
+    template<typename _Up, typename... _Args>
+    requires is_constructible_v<_Tp, initializer_list<_Up>&, _Args&&...>
+    constexpr _Tp&
+    emplace(initializer_list<_Up> __il, _Args&&... __args)
+    {
+        reset();
+        _M_construct(__il, std::forward<_Args>(__args)...);
+        return _M_payload;
+    }
+
+    // Swap.
+    constexpr void
+    swap(optional& __other)
+    noexcept(is_nothrow_move_constructible_v<_Tp>
+             && is_nothrow_swappable_v<_Tp>)
+    {
+        using std::swap;
+
+        if (_M_engaged && __other._M_engaged) {
+            swap(_M_payload, __other._M_payload);
+        } else if (_M_engaged) {
+            __other._M_construct(std::move(_M_payload));
+            _M_destruct();
+        } else if (__other._M_engaged) {
+            _M_construct(std::move(__other._M_payload));
+            __other._M_destruct();
+        }
+    }
+
+    // Observers.
+    constexpr explicit operator bool() const noexcept
+    {
+        return _M_engaged;
+    }
+
+    constexpr bool has_value() const noexcept
+    {
+        return _M_engaged;
+    }
+
+#ifdef _GLIBCXX_OPTIONAL_DEDUCING_THIS
+    template<typename _Self>
+    constexpr auto
+    operator->(this _Self&& __self) noexcept
+    {
+        __glibcxx_assert(__self._M_engaged);
+        return std::__addressof(
+                   static_cast<__like_t<_Self&>>(__self._M_payload));
+    }
+
+    template<typename _Self>
+    constexpr __like_t<_Self>
+    operator*(this _Self&& __self) noexcept
+    {
+        __glibcxx_assert(__self._M_engaged);
+        return static_cast<__like_t<_Self>>(__self._M_payload);
+    }
+
+    template<typename _Self>
+    constexpr __like_t<_Self>
+    value(this _Self&& __self)
+    {
+        if (!__self._M_engaged) {
+            __throw_bad_optional_access();
+        }
+        return static_cast<__like_t<_Self>>(__self._M_payload);
+    }
+
+    template<typename _Self, typename _Up>
+    constexpr _Tp
+    value_or(this _Self&& __self, _Up&& __u)
+    {
+        static_assert(is_constructible_v<_Tp, __like_t<_Self>>);
+        static_assert(is_convertible_v<_Up&&, _Tp>);
+
+        return __self._M_engaged
+               ? static_cast<__like_t<_Self>>(__self._M_payload)
+               : static_cast<_Tp>(std::forward<_Up>(__u));
+    }
+
+    // Monadic operations.
+    template<typename _Self, typename _Fn>
+    constexpr auto
+    and_then(this _Self&& __self, _Fn&& __f)
+    {
+        using _Up = remove_cvref_t<invoke_result_t<_Fn, __like_t<_Self>>>;
+        static_assert(__is_optional_v<_Up>);
+        if (__self._M_engaged) {
+            return std::__invoke(std::forward<_Fn>(__f),
+                       static_cast<__like_t<_Self>>(__self._M_payload));
+        }
+        return _Up();
+    }
+
+    // The result of __f initializes the new contained value directly.
+    template<typename _Self, typename _Fn>
+    constexpr auto
+    transform(this _Self&& __self, _Fn&& __f)
+    {
+        using _Up = remove_cv_t<invoke_result_t<_Fn, __like_t<_Self>>>;
+        if (__self._M_engaged) {
+            return optional<_Up>(_Optional_func<_Fn>{__f},
+                       static_cast<__like_t<_Self>>(__self._M_payload));
+        }
+        return optional<_Up>();
+    }
+
+    template<typename _Self, typename _Fn>
+    constexpr optional
+    or_else(this _Self&& __self, _Fn&& __f)
+    {
+        static_assert(is_constructible_v<optional, _Self>);
+        static_assert(is_same_v<remove_cvref_t<invoke_result_t<_Fn>>,
+                                optional>);
+        if (__self._M_engaged) {
+            return std::forward<_Self>(__self);
+        }
+        return std::forward<_Fn>(__f)();
+    }
+#else
+    constexpr const _Tp*
+    operator->() const noexcept
+    {
+        __glibcxx_assert(_M_engaged);
+        return std::__addressof(_M_payload);
+    }
+
+    constexpr _Tp*
+    operator->() noexcept
+    {
+        __glibcxx_assert(_M_engaged);
+        return std::__addressof(_M_payload);
+    }
+
+    constexpr const _Tp&
+    operator*() const& noexcept
+    {
+        __glibcxx_assert(_M_engaged);
+        return _M_payload;
+    }
+
+    constexpr _Tp&
+    operator*()& noexcept
+    {
+        __glibcxx_assert(_M_engaged);
+        return _M_payload;
+    }
+
+    constexpr _Tp&&
+    operator*()&& noexcept
+    {
+        __glibcxx_assert(_M_engaged);
+        return std::move(_M_payload);
+    }
+
+    constexpr const _Tp&&
+    operator*() const&& noexcept
+    {
+        __glibcxx_assert(_M_engaged);
+        return std::move(_M_payload);
+    }
+
+    constexpr const _Tp&
+    value() const&
+    {
+        if (!_M_engaged) {
+            __throw_bad_optional_access();
+        }
+        return _M_payload;
+    }
+
+    constexpr _Tp&
+    value()&
+    {
+        if (!_M_engaged) {
+            __throw_bad_optional_access();
+        }
+        return _M_payload;
+    }
+
+    constexpr _Tp&&
+    value()&&
+    {
+        if (!_M_engaged) {
+            __throw_bad_optional_access();
+        }
+        return std::move(_M_payload);
+    }
+
+    constexpr const _Tp&&
+    value() const&&
+    {
+        if (!_M_engaged) {
+            __throw_bad_optional_access();
+        }
+        return std::move(_M_payload);
+    }
+
+    template<typename _Up>
+    constexpr _Tp
+    value_or(_Up&& __u) const&
+    {
+        static_assert(is_copy_constructible_v<_Tp>);
+        static_assert(is_convertible_v<_Up&&, _Tp>);
+
+        return _M_engaged ? _M_payload
+                          : static_cast<_Tp>(std::forward<_Up>(__u));
+    }
+
+    template<typename _Up>
+    constexpr _Tp
+    value_or(_Up&& __u) &&
+    {
+        static_assert(is_move_constructible_v<_Tp>);
+        static_assert(is_convertible_v<_Up&&, _Tp>);
+
+        return _M_engaged ? std::move(_M_payload)
+                          : static_cast<_Tp>(std::forward<_Up>(__u));
+    }
+
+    // Monadic operations.
+    template<typename _Fn>
+    constexpr auto
+    and_then(_Fn&& __f) &
+    {
+        using _Up = remove_cvref_t<invoke_result_t<_Fn, _Tp&>>;
+        static_assert(__is_optional_v<_Up>);
+        if (_M_engaged) {
+            return std::__invoke(std::forward<_Fn>(__f), **this);
+        }
+        return _Up();
+    }
+
+    template<typename _Fn>
+    constexpr auto
+    and_then(_Fn&& __f) const&
+    {
+        using _Up = remove_cvref_t<invoke_result_t<_Fn, const _Tp&>>;
+        static_assert(__is_optional_v<_Up>);
+        if (_M_engaged) {
+            return std::__invoke(std::forward<_Fn>(__f), **this);
+        }
+        return _Up();
+    }
+
+    template<typename _Fn>
+    constexpr auto
+    and_then(_Fn&& __f) &&
+    {
+        using _Up = remove_cvref_t<invoke_result_t<_Fn, _Tp>>;
+        static_assert(__is_optional_v<_Up>);
+        if (_M_engaged) {
+            return std::__invoke(std::forward<_Fn>(__f), *std::move(*this));
+        }
+        return _Up();
+    }
+
+    template<typename _Fn>
+    constexpr auto
+    and_then(_Fn&& __f) const&&
+    {
+        using _Up = remove_cvref_t<invoke_result_t<_Fn, const _Tp>>;
+        static_assert(__is_optional_v<_Up>);
+        if (_M_engaged) {
+            return std::__invoke(std::forward<_Fn>(__f), *std::move(*this));
+        }
+        return _Up();
+    }
+
+    // The result of __f initializes the new contained value directly.
+    template<typename _Fn>
+    constexpr auto
+    transform(_Fn&& __f) &
+    {
+        using _Up = remove_cv_t<invoke_result_t<_Fn, _Tp&>>;
+        if (_M_engaged) {
+            return optional<_Up>(_Optional_func<_Fn>{__f}, **this);
+        }
+        return optional<_Up>();
+    }
+
+    template<typename _Fn>
+    constexpr auto
+    transform(_Fn&& __f) const&
+    {
+        using _Up = remove_cv_t<invoke_result_t<_Fn, const _Tp&>>;
+        if (_M_engaged) {
+            return optional<_Up>(_Optional_func<_Fn>{__f}, **this);
+        }
+        return optional<_Up>();
+    }
+
+    template<typename _Fn>
+    constexpr auto
+    transform(_Fn&& __f) &&
+    {
+        using _Up = remove_cv_t<invoke_result_t<_Fn, _Tp>>;
+        if (_M_engaged) {
+            return optional<_Up>(_Optional_func<_Fn>{__f},
+                                 *std::move(*this));
+        }
+        return optional<_Up>();
+    }
+
+    template<typename _Fn>
+    constexpr auto
+    transform(_Fn&& __f) const&&
+    {
+        using _Up = remove_cv_t<invoke_result_t<_Fn, const _Tp>>;
+        if (_M_engaged) {
+            return optional<_Up>(_Optional_func<_Fn>{__f},
+                                 *std::move(*this));
+        }
+        return optional<_Up>();
+    }
+
+    template<typename _Fn>
+    constexpr optional
+    or_else(_Fn&& __f) const&
+    {
+        static_assert(is_copy_constructible_v<_Tp>);
+        static_assert(is_same_v<remove_cvref_t<invoke_result_t<_Fn>>,
+                                optional>);
+        if (_M_engaged) {
+            return *this;
+        }
+        return std::forward<_Fn>(__f)();
+    }
+
+    template<typename _Fn>
+    constexpr optional
+    or_else(_Fn&& __f) &&
+    {
+        static_assert(is_move_constructible_v<_Tp>);
+        static_assert(is_same_v<remove_cvref_t<invoke_result_t<_Fn>>,
+                                optional>);
+        if (_M_engaged) {
+            return std::move(*this);
+        }
+        return std::forward<_Fn>(__f)();
+    }
+#endif // _GLIBCXX_OPTIONAL_DEDUCING_THIS
+
+    constexpr void
+    reset() noexcept
+    {
+        if (_M_engaged) {
+            _M_destruct();
+        }
+    }
+};
+
+template<typename _Tp>
+using __optional_relop_t =
+enable_if_t<is_convertible<_Tp, bool>::value, bool>;
+
+// Comparisons between optional values.
+template<typename _Tp, typename _Up>
+constexpr auto
+operator==(const optional<_Tp>& __lhs, const optional<_Up>& __rhs)
+-> __optional_relop_t<decltype(declval<_Tp>() == declval<_Up>())> {
+    return static_cast<bool>(__lhs) == static_cast<bool>(__rhs)
+    && (!__lhs || *__lhs == *__rhs);
+}
+
+template<typename _Tp, typename _Up>
+constexpr auto
+operator!=(const optional<_Tp>& __lhs, const optional<_Up>& __rhs)
+-> __optional_relop_t<decltype(declval<_Tp>() != declval<_Up>())> {
+    return static_cast<bool>(__lhs) != static_cast<bool>(__rhs)
+    || (static_cast<bool>(__lhs) && *__lhs != *__rhs);
+}
+
+template<typename _Tp, typename _Up>
+constexpr auto
+operator<(const optional<_Tp>& __lhs, const optional<_Up>& __rhs)
+-> __optional_relop_t<decltype(declval<_Tp>() < declval<_Up>())> {
+    return static_cast<bool>(__rhs) && (!__lhs || *__lhs < *__rhs);
+}
+
+template<typename _Tp, typename _Up>
+constexpr auto
+operator>(const optional<_Tp>& __lhs, const optional<_Up>& __rhs)
+-> __optional_relop_t<decltype(declval<_Tp>() > declval<_Up>())> {
+    return static_cast<bool>(__lhs) && (!__rhs || *__lhs > *__rhs);
+}
+
+template<typename _Tp, typename _Up>
+constexpr auto
+operator<=(const optional<_Tp>& __lhs, const optional<_Up>& __rhs)
+-> __optional_relop_t<decltype(declval<_Tp>() <= declval<_Up>())> {
+    return !__lhs || (static_cast<bool>(__rhs) && *__lhs <= *__rhs);
+}
+
+template<typename _Tp, typename _Up>
+constexpr auto
+operator>=(const optional<_Tp>& __lhs, const optional<_Up>& __rhs)
+-> __optional_relop_t<decltype(declval<_Tp>() >= declval<_Up>())> {
+    return !__rhs || (static_cast<bool>(__lhs) && *__lhs >= *__rhs);
+}
+
+template<typename _Tp, three_way_comparable_with<_Tp> _Up>
+constexpr compare_three_way_result_t<_Tp, _Up>
+operator<=>(const optional<_Tp>& __x, const optional<_Up>& __y) {
+    return __x && __y ? *__x <=> *__y : bool(__x) <=> bool(__y);
+}
+
+// Comparisons with nullopt.
+template<typename _Tp>
+constexpr bool
+operator==(const optional<_Tp>& __lhs, nullopt_t) noexcept {
+    return !__lhs;
+}
+
+template<typename _Tp>
+constexpr strong_ordering
+operator<=>(const optional<_Tp>& __x, nullopt_t) noexcept {
+    return bool(__x) <=> false;
+}
+
+// Comparisons with value type.
+template<typename _Tp, typename _Up>
+constexpr auto
+operator==(const optional<_Tp>& __lhs, const _Up& __rhs)
+-> __optional_relop_t<decltype(declval<_Tp>() == declval<_Up>())>
+{ return __lhs && *__lhs == __rhs; }
+
+template<typename _Tp, typename _Up>
+constexpr auto
+operator==(const _Up& __lhs, const optional<_Tp>& __rhs)
+-> __optional_relop_t<decltype(declval<_Up>() == declval<_Tp>())>
+{ return __rhs && __lhs == *__rhs; }
+
+template<typename _Tp, typename _Up>
+constexpr auto
+operator!=(const optional<_Tp>& __lhs, const _Up& __rhs)
+-> __optional_relop_t<decltype(declval<_Tp>() != declval<_Up>())>
+{ return !__lhs || *__lhs != __rhs; }
+
+template<typename _Tp, typename _Up>
+constexpr auto
+operator!=(const _Up& __lhs, const optional<_Tp>& __rhs)
+-> __optional_relop_t<decltype(declval<_Up>() != declval<_Tp>())>
+{ return !__rhs || __lhs != *__rhs; }
+
+template<typename _Tp, typename _Up>
+constexpr auto
+operator<(const optional<_Tp>& __lhs, const _Up& __rhs)
+-> __optional_relop_t<decltype(declval<_Tp>() < declval<_Up>())>
+{ return !__lhs || *__lhs < __rhs; }
+
+template<typename _Tp, typename _Up>
+constexpr auto
+operator<(const _Up& __lhs, const optional<_Tp>& __rhs)
+-> __optional_relop_t<decltype(declval<_Up>() < declval<_Tp>())>
+{ return __rhs && __lhs < *__rhs; }
+
+template<typename _Tp, typename _Up>
+constexpr auto
+operator>(const optional<_Tp>& __lhs, const _Up& __rhs)
+-> __optional_relop_t<decltype(declval<_Tp>() > declval<_Up>())>
+{ return __lhs && *__lhs > __rhs; }
+
+template<typename _Tp, typename _Up>
+constexpr auto
+operator>(const _Up& __lhs, const optional<_Tp>& __rhs)
+-> __optional_relop_t<decltype(declval<_Up>() > declval<_Tp>())>
+{ return !__rhs || __lhs > *__rhs; }
+
+template<typename _Tp, typename _Up>
+constexpr auto
+operator<=(const optional<_Tp>& __lhs, const _Up& __rhs)
+-> __optional_relop_t<decltype(declval<_Tp>() <= declval<_Up>())>
+{ return !__lhs || *__lhs <= __rhs; }
+
+template<typename _Tp, typename _Up>
+constexpr auto
+operator<=(const _Up& __lhs, const optional<_Tp>& __rhs)
+-> __optional_relop_t<decltype(declval<_Up>() <= declval<_Tp>())>
+{ return __rhs && __lhs <= *__rhs; }
+
+template<typename _Tp, typename _Up>
+constexpr auto
+operator>=(const optional<_Tp>& __lhs, const _Up& __rhs)
+-> __optional_relop_t<decltype(declval<_Tp>() >= declval<_Up>())>
+{ return __lhs && *__lhs >= __rhs; }
+
+template<typename _Tp, typename _Up>
+constexpr auto
+operator>=(const _Up& __lhs, const optional<_Tp>& __rhs)
+-> __optional_relop_t<decltype(declval<_Up>() >= declval<_Tp>())>
+{ return !__rhs || __lhs >= *__rhs; }
+
+template<typename _Tp, typename _Up>
+requires (!__is_optional_v<_Up>) && three_way_comparable_with<_Up, _Tp>
+constexpr compare_three_way_result_t<_Tp, _Up>
+operator<=>(const optional<_Tp>& __x, const _Up& __v) {
+    return bool(__x) ? *__x <=> __v : strong_ordering::less;
+}
+
+// Swap and creation functions.
+
+// _GLIBCXX_RESOLVE_LIB_DEFECTS
+// 2748. swappable traits for optionals
+template<typename _Tp>
+constexpr inline enable_if_t<is_move_constructible_v<_Tp> && is_swappable_v<_Tp>>
+swap(optional<_Tp>& __lhs, optional<_Tp>& __rhs)
+noexcept(noexcept(__lhs.swap(__rhs))) {
+    __lhs.swap(__rhs);
+}
+
+template<typename _Tp>
+enable_if_t<!(is_move_constructible_v<_Tp> && is_swappable_v<_Tp>)>
+swap(optional<_Tp>&, optional<_Tp>&) = delete;
+
+template<typename _Tp>
+constexpr optional<decay_t<_Tp>>
+make_optional(_Tp&& __t) {
+    return optional<decay_t<_Tp>> { std::forward<_Tp>(__t) };
+}
+
+template<typename _Tp, typename ..._Args>
+constexpr optional<_Tp>
+make_optional(_Args&&... __args) {
+    return optional<_Tp> { in_place, std::forward<_Args>(__args)... };
+}
+
+template<typename _Tp, typename _Up, typename ..._Args>
+constexpr optional<_Tp>
+make_optional(initializer_list<_Up> __il, _Args&&... __args) {
+    return optional<_Tp> { in_place, __il, std::forward<_Args>(__args)... };
+}
+
+// Hash.
+
+template<typename _Tp, typename _Up = remove_const_t<_Tp>,
+         bool = __poison_hash<_Up>::__enable_hash_call>
+struct __optional_hash_call_base {
+    size_t
+    operator()(const optional<_Tp>& __t) const
+    noexcept(noexcept(hash<_Up> {}(*__t)))
+    {
+        // We pick an arbitrary hash for disengaged optionals which hopefully
+        // usual values of _Tp won't typically hash to.
+        constexpr size_t __magic_disengaged_hash = static_cast<size_t>(-3333);
+        return __t ? hash<_Up> {}(*__t) : __magic_disengaged_hash;
+    }
+};
+
+template<typename _Tp, typename _Up>
+struct __optional_hash_call_base<_Tp, _Up, false> {};
+
+template<typename _Tp>
+struct hash<optional<_Tp>>
+: private __poison_hash<remove_const_t<_Tp>>,
+public __optional_hash_call_base<_Tp> {
+    using result_type [[__deprecated__]] = size_t;
+    using argument_type [[__deprecated__]] = optional<_Tp>;
+};
+
+template<typename _Tp>
+struct __is_fast_hash<hash<optional<_Tp>>> : __is_fast_hash<hash<_Tp>> {
+};
+
+/// @}
+
+template <typename _Tp> optional(_Tp) -> optional<_Tp>;
+
+_GLIBCXX_END_NAMESPACE_VERSION
+} // namespace std
+
+#undef _GLIBCXX_OPTIONAL_DEDUCING_THIS
+
+#endif // C++20
+
+#endif // _GLIBCXX_OPTIONAL
@@ -0,0 +1,189 @@
+// Checks for optional.h, in either configuration: with explicit object
+// parameters (_GLIBCXX_OPTIONAL_DEDUCING_THIS) and with the ref-qualified
+// fallback. Everything but main is checked by static_assert, so a compiler
+// front end alone can verify the deducing-this branch.
+//
+//   g++ -std=c++20 -I. optional_test.cc && ./a.out
+//   ./optional_test.sh        both configurations, see there
+
+#include "optional.h"
+// These build on fixed_optional.h, which optional.h stands in for.
+#include "../2231_constexpr_optional_variant/once_optional.h"
+#include "../2231_constexpr_optional_variant/recycling_optional.h"
+
+#include <string>
+#include <vector>
+
+namespace
+{
+using std::optional;
+using std::is_same_v;
+
+// The condition under which optional.h uses explicit object parameters.
+#if __cpp_explicit_this_parameter >= 202110L \
+    && __cpp_lib_forward_like >= 202207L
+# define OPTIONAL_TEST_DEDUCING_THIS 1
+#elif defined OPTIONAL_TEST_EXPECT_DEDUCING_THIS
+# error "explicit object parameters not enabled"
+#endif
+
+#ifdef OPTIONAL_TEST_DEDUCING_THIS
+// The address of an explicit object member function is a plain function
+// pointer, so this only holds in that configuration. (Through a variable:
+// Clang 18 gets decltype(&optional<int>::value<...>) wrong.)
+constexpr auto value_address = &optional<int>::value<optional<int>&>;
+static_assert(is_same_v<decltype(value_address),
+                        int& (* const)(optional<int>&)>);
+#endif
+
+struct Move_only {
+    int _M_i;
+    constexpr explicit Move_only(int __i) : _M_i(__i) { }
+    Move_only(Move_only&&) = default;
+    Move_only& operator=(Move_only&&) = default;
+};
+
+// Value categories of the observers, for a mutable and a const payload.
+template<typename _Tp>
+constexpr bool
+check_categories()
+{
+    using _O = optional<_Tp>;
+    static_assert(is_same_v<decltype(*std::declval<_O&>()), _Tp&>);
+    static_assert(is_same_v<decltype(*std::declval<const _O&>()), const _Tp&>);
+    static_assert(is_same_v<decltype(*std::declval<_O>()), _Tp&&>);
+    static_assert(is_same_v<decltype(*std::declval<const _O>()), const _Tp&&>);
+    static_assert(is_same_v<decltype(std::declval<_O&>().value()), _Tp&>);
+    static_assert(is_same_v<decltype(std::declval<const _O&>().value()),
+                            const _Tp&>);
+    static_assert(is_same_v<decltype(std::declval<_O>().value()), _Tp&&>);
+    static_assert(is_same_v<decltype(std::declval<const _O>().value()),
+                            const _Tp&&>);
+    static_assert(is_same_v<decltype(std::declval<_O&>().operator->()), _Tp*>);
+    static_assert(is_same_v<decltype(std::declval<const _O&>().operator->()),
+                            const _Tp*>);
+    return true;
+}
+
+static_assert(check_categories<int>());
+static_assert(check_categories<const int>());
+static_assert(check_categories<std::string>());
+
+// The monadic operations pass the payload with the category of the object.
+struct Category {
+    constexpr int operator()(int&) const { return 1; }
+    constexpr int operator()(const int&) const { return 2; }
+    constexpr int operator()(int&&) const { return 3; }
+    constexpr int operator()(const int&&) const { return 4; }
+};
+
+constexpr bool
+check_monadic()
+{
+    optional<int> __o(7);
+    const optional<int> __c(7);
+    Category __cat;
+    if (*__o.transform(__cat) != 1 || *__c.transform(__cat) != 2
+        || *std::move(__o).transform(__cat) != 3
+        || *std::move(__c).transform(__cat) != 4) {
+        return false;
+    }
+    auto __some = [](int __i) { return optional<long>(__i * 2); };
+    if (*__o.and_then(__some) != 14 || __o.and_then(__some).value() != 14
+        || optional<int>().and_then(__some).has_value()) {
+        return false;
+    }
+    auto __none = [] { return optional<int>(3); };
+    if (*optional<int>().or_else(__none) != 3 || *__o.or_else(__none) != 7) {
+        return false;
+    }
+    if (__o.value_or(1) != 7 || optional<int>().value_or(1) != 1) {
+        return false;
+    }
+    // A move-only result is constructed in place.
+    auto __mo = __o.transform([](int __i) { return Move_only(__i); });
+    if (__mo->_M_i != 7 || std::move(__mo).value()._M_i != 7) {
+        return false;
+    }
+    return true;
+}
+
+static_assert(check_monadic());
+static_assert(is_same_v<decltype(optional<int>().transform(Category{})),
+                        optional<int>>);
+static_assert(is_same_v<decltype(optional<int>().and_then(
+                            [](int) { return optional<char>(); })),
+                        optional<char>>);
+
+// Not trivially copyable or destructible, so that the user-provided
+// special members are the ones used.
+struct Tracked {
+    int _M_i;
+    constexpr Tracked(int __i) : _M_i(__i) { }
+    constexpr Tracked(const Tracked& __t) : _M_i(__t._M_i + 100) { }
+    constexpr Tracked(Tracked&& __t) : _M_i(__t._M_i) { __t._M_i = -1; }
+    constexpr Tracked& operator=(const Tracked& __t)
+    { _M_i = __t._M_i + 1000; return *this; }
+    constexpr Tracked& operator=(Tracked&&) = default;
+    constexpr ~Tracked() { }
+};
+
+constexpr bool
+check_special_members()
+{
+    optional<Tracked> __a(1), __b;
+    __b = __a;                                // constructs: 101
+    optional<Tracked> __c(std::move(__a));    // moves: 1, __a holds -1
+    __c = __b;                                // assigns: 1101
+    __a.swap(__b);
+    return __a->_M_i == 101 && __b->_M_i == -1 && __c->_M_i == 1101;
+}
+static_assert(check_special_members());
+static_assert(std::is_trivially_copyable_v<optional<int>>);
+static_assert(!std::is_trivially_copyable_v<optional<Tracked>>);
+static_assert(!std::is_copy_constructible_v<optional<Move_only>>);
+static_assert(std::is_nothrow_move_constructible_v<optional<Move_only>>);
+
+// once_optional and recycling_optional take their storage from optional.h.
+// once_optional constructs the factory's prvalue in place, so _Tp need not
+// be movable, and calls the factory as an lvalue.
+struct Pinned {
+    int _M_i;
+    explicit Pinned(int __i) : _M_i(__i) { }
+    Pinned(Pinned&&) = delete;
+};
+
+struct Make_pinned {
+    Pinned operator()() & { return Pinned(5); }
+    Pinned operator()() && = delete;
+};
+
+static_assert(sizeof(std::once_optional<int>) >= sizeof(int));
+static_assert(sizeof(std::recycling_optional<std::string>)
+              > sizeof(std::string));
+} // namespace
+
+int
+main()
+{
+    std::once_optional<std::string> __once;
+    std::once_optional<Pinned> __pinned;
+    std::recycling_optional<std::string> __rec;
+    __rec.emplace("recycled");
+    // An rvalue is moved into a dormant object, bringing its own buffer;
+    // an lvalue is copied into the buffer the dormant object kept.
+    std::recycling_optional<std::vector<int>> __buf(std::in_place, 64, 0);
+    __buf.reset();
+    std::vector<int> __moved(8, 1);
+    const int* __p = __moved.data();
+    __buf = std::move(__moved);
+    bool __reused = __buf->data() == __p;
+    __buf.reset();
+    std::vector<int> __copied(4, 2);
+    __buf = __copied;
+    __reused = __reused && __buf->data() == __p && (*__buf)[3] == 2;
+    return __once.get_or_init([] { return std::string("x"); }) == "x"
+           && __pinned.get_or_init(Make_pinned{})._M_i == 5
+           && *__rec == "recycled" && __reused && check_monadic()
+           ? 0 : 1;
+}
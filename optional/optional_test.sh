@@ -0,0 +1,23 @@
+#!/bin/sh
+# Builds and runs optional_test.cc with each compiler given, checking the
+# configuration of optional.h that compiler selects. GCC 14 and later have
+# explicit object parameters and forward_like, and so check the
+# deducing-this branch; earlier versions check the fallback.
+#
+#   ./optional_test.sh [compiler...]          default: g++
+
+cd "$(dirname "$0")" || exit 1
+out=$(mktemp) || exit 1
+trap 'rm -f "$out"' EXIT
+
+[ $# -gt 0 ] || set -- g++
+status=0
+for cxx in "$@"; do
+    if $cxx -std=c++2b -Wall -Wextra -I. -o "$out" optional_test.cc \
+       && "$out"; then
+        echo "$cxx: ok"
+    else
+        echo "$cxx: FAILED"; status=1
+    fi
+done
+exit $status